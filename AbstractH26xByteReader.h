@@ -15,6 +15,11 @@ namespace Mmp
 namespace Codec
 {
 
+/**
+ * @note H26xBinaryReader never calls the reader per byte: bits are extracted from contiguous memory,
+ *       either the buffer of Data() (no virtual call at all once constructed) or a look-ahead window
+ *       filled by Read in chunks of 64 KiB
+ */
 class AbstractH26xByteReader
 {
 public:
@@ -43,6 +48,17 @@ public:
      * @brief reach the end of the stream
      */
     virtual bool Eof() = 0;
+public:
+    /**
+     * @brief  the whole byte stream as a contiguous buffer, if the implemention holds one
+     * @return nullptr if not available
+     * @note   when available, H26xBinaryReader parses from it directly instead of calling Read
+     */
+    virtual const uint8_t* Data() { return nullptr; }
+    /**
+     * @brief size of the buffer returned by Data()
+     */
+    virtual size_t Size() { return 0; }
 };
 
 } // namespace Codec
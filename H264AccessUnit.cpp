@@ -0,0 +1,152 @@
+#include "H264AccessUnit.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H264AccessUnitAssembler::H264AccessUnitAssembler()
+{
+    _vcl = false;
+    _prevNalRefIdc = 0;
+    _prevNalUnitType = 0;
+}
+
+H264AccessUnit::ptr H264AccessUnitAssembler::Push(const H264NalSyntax::ptr& nal)
+{
+    return Append(nal, nullptr);
+}
+
+H264AccessUnit::ptr H264AccessUnitAssembler::Push(const H264NalSyntax::ptr& nal, const H26xNalUnitView& view)
+{
+    return Append(nal, &view);
+}
+
+H264AccessUnit::ptr H264AccessUnitAssembler::Flush()
+{
+    if (!_au)
+    {
+        return nullptr;
+    }
+    return Emit();
+}
+
+H264AccessUnit::ptr H264AccessUnitAssembler::Append(const H264NalSyntax::ptr& nal, const H26xNalUnitView* view)
+{
+    static const uint8_t kStartCode[4] = {0x00, 0x00, 0x00, 0x01};
+    H264AccessUnit::ptr completed;
+    bool firstOfNext = false;
+    // See also : ISO 14496/10(2020) - 7.4.1.2.3 Order of NAL units and coded pictures and association to access units
+    switch (nal->nal_unit_type)
+    {
+        case H264NaluType::MMP_H264_NALU_TYPE_SLICE:
+        case H264NaluType::MMP_H264_NALU_TYPE_DPA:
+        case H264NaluType::MMP_H264_NALU_TYPE_IDR:
+        {
+            firstOfNext = _vcl && IsFirstVclNalUnit(nal, view);
+            break;
+        }
+        case H264NaluType::MMP_H264_NALU_TYPE_SEI:
+        case H264NaluType::MMP_H264_NALU_TYPE_SPS:
+        case H264NaluType::MMP_H264_NALU_TYPE_PPS:
+        case H264NaluType::MMP_H264_NALU_TYPE_AUD:
+        case H264NaluType::MMP_H264_NALU_TYPE_PREFIX:
+        case H264NaluType::MMP_H264_NALU_TYPE_SUB_SPS:
+        case 16: case 17: case 18: /* reserved */
+        {
+            // Hint : they start an access unit when following the last vcl nal unit of the primary coded picture
+            firstOfNext = _vcl;
+            break;
+        }
+        default:
+            break;
+    }
+    if (firstOfNext)
+    {
+        completed = Emit();
+    }
+    if (!_au)
+    {
+        _au = std::make_shared<H264AccessUnit>();
+    }
+    _au->nals.push_back(nal);
+    if (view)
+    {
+        size_t startCodeLength = view->startCodeLength == 3 ? 3 : 4;
+        _au->bytes.insert(_au->bytes.end(), kStartCode + 4 - startCodeLength, kStartCode + 4);
+        _au->bytes.insert(_au->bytes.end(), view->data, view->data + view->size);
+        // Hint : bytes may still be reallocated, data is set by Emit
+        _au->views.push_back(*view);
+        _au->views.back().startCodeLength = (uint8_t)startCodeLength;
+        _au->views.back().data = nullptr;
+    }
+    if (nal->nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_SLICE ||
+        nal->nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_DPA   ||
+        nal->nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_IDR
+    )
+    {
+        _vcl = true;
+        _prevNalRefIdc = nal->nal_ref_idc;
+        _prevNalUnitType = nal->nal_unit_type;
+        _prevSlice = nal->slice;
+    }
+    else if (nal->nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_EOSEQ ||
+             nal->nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_EOSTREAM
+    )
+    {
+        // Hint : end of sequence and end of stream are the last nal units of their access unit
+        completed = Emit();
+    }
+    return completed;
+}
+
+bool H264AccessUnitAssembler::IsFirstVclNalUnit(const H264NalSyntax::ptr& nal, const H26xNalUnitView* view)
+{
+    const H264SliceHeaderSyntax::ptr& slice = nal->slice;
+    if (!slice || !_prevSlice)
+    {
+        // Hint : slice header not deserialized, e.g. not subscribed
+        return view && ClassifyNalUnit(MMP_H26X_CODEC_H264, view->data, view->size).firstSliceInPicture;
+    }
+    // See also : ISO 14496/10(2020) - 7.4.1.2.4 Detection of the first VCL NAL unit of a primary coded picture
+    // Hint : syntax elements not present are inferred to 0 on both sides, so they are compared without
+    //        looking up pic_order_cnt_type in the SPS
+    bool idrPicFlag = nal->nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_IDR;
+    bool prevIdrPicFlag = _prevNalUnitType == H264NaluType::MMP_H264_NALU_TYPE_IDR;
+    if (slice->frame_num != _prevSlice->frame_num ||
+        slice->pic_parameter_set_id != _prevSlice->pic_parameter_set_id ||
+        slice->field_pic_flag != _prevSlice->field_pic_flag ||
+        slice->bottom_field_flag != _prevSlice->bottom_field_flag ||
+        (nal->nal_ref_idc == 0) != (_prevNalRefIdc == 0) ||
+        slice->pic_order_cnt_lsb != _prevSlice->pic_order_cnt_lsb ||
+        slice->delta_pic_order_cnt_bottom != _prevSlice->delta_pic_order_cnt_bottom ||
+        slice->delta_pic_order_cnt[0] != _prevSlice->delta_pic_order_cnt[0] ||
+        slice->delta_pic_order_cnt[1] != _prevSlice->delta_pic_order_cnt[1] ||
+        idrPicFlag != prevIdrPicFlag ||
+        (idrPicFlag && slice->idr_pic_id != _prevSlice->idr_pic_id)
+    )
+    {
+        return true;
+    }
+    // Hint : a picture only starts again at the first macroblock, slices of redundant coded pictures excluded
+    return slice->first_mb_in_slice == 0 && slice->redundant_pic_cnt == 0;
+}
+
+H264AccessUnit::ptr H264AccessUnitAssembler::Emit()
+{
+    H264AccessUnit::ptr au = _au;
+    size_t offset = 0;
+    for (auto& view : au->views)
+    {
+        offset += view.startCodeLength;
+        view.data = au->bytes.data() + offset;
+        offset += view.size;
+    }
+    _au = nullptr;
+    _vcl = false;
+    _prevSlice = nullptr;
+    return au;
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,88 @@
+//
+// H264AccessUnit.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+// 
+
+#pragma once
+
+#include <vector>
+
+#include "H264Common.h"
+#include "H26xNalIterator.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief nal units of one primary coded picture, in decoding order
+ * @sa    ISO 14496/10(2020) - 7.4.1.2.3 Order of NAL units and coded pictures and association to access units
+ */
+class H264AccessUnit
+{
+public:
+    using ptr = std::shared_ptr<H264AccessUnit>;
+public:
+    H264AccessUnit() = default;
+    ~H264AccessUnit() = default;
+public:
+    std::vector<H264NalSyntax::ptr> nals;
+    /**
+     * @note one per nal unit if the nal units are pushed with their views, otherwise empty;
+     *       offset is the one in the source byte stream, data points into bytes
+     */
+    std::vector<H26xNalUnitView>    views;
+    std::vector<uint8_t>            bytes;   // copy of the Annex B byte stream of the access unit, start codes included
+};
+
+/**
+ * @brief group deserialized nal units into access units
+ * @note  an access unit is only known to be complete when the first nal unit of the next one arrives,
+ *        or on end of sequence, end of stream and Flush
+ */
+class H264AccessUnitAssembler
+{
+public:
+    using ptr = std::shared_ptr<H264AccessUnitAssembler>;
+public:
+    H264AccessUnitAssembler();
+    ~H264AccessUnitAssembler() = default;
+public:
+    /**
+     * @brief     push the next nal unit in decoding order
+     * @param[in] nal
+     * @return    the access unit completed by this nal unit, nullptr if none
+     */
+    H264AccessUnit::ptr Push(const H264NalSyntax::ptr& nal);
+    /**
+     * @brief     push the next nal unit in decoding order with its raw bytes, which are copied
+     * @param[in] nal
+     * @param[in] view e.g. from H26xNalIterator, only needs to be valid during the call
+     * @return    the access unit completed by this nal unit, nullptr if none
+     * @note      when the slice header is not deserialized (e.g. not subscribed),
+     *            the picture boundary falls back to first_mb_in_slice equal to 0 decoded from the view
+     */
+    H264AccessUnit::ptr Push(const H264NalSyntax::ptr& nal, const H26xNalUnitView& view);
+    /**
+     * @brief  end of the byte stream
+     * @return the last access unit, nullptr if none
+     */
+    H264AccessUnit::ptr Flush();
+private:
+    H264AccessUnit::ptr Append(const H264NalSyntax::ptr& nal, const H26xNalUnitView* view);
+    bool IsFirstVclNalUnit(const H264NalSyntax::ptr& nal, const H26xNalUnitView* view);
+    H264AccessUnit::ptr Emit();
+private:
+    H264AccessUnit::ptr _au;
+    bool _vcl;                                 // the access unit in progress has a vcl nal unit
+    uint8_t _prevNalRefIdc;
+    uint8_t _prevNalUnitType;
+    H264SliceHeaderSyntax::ptr _prevSlice;     // of the last vcl nal unit
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -141,6 +141,11 @@ H264SeiFilmGrainSyntax::H264SeiFilmGrainSyntax()
     film_grain_characteristics_repetition_period = 0;
 }
 
+H264ParameterSetBytes::H264ParameterSetBytes()
+{
+    hash = 0;
+}
+
 H264ContextSyntax::H264ContextSyntax()
 {
 }
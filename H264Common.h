@@ -955,10 +955,24 @@ public:
     int8_t   emulation_prevention_three_byte;
     H264SpsSyntax::ptr          sps;
     H264PpsSyntax::ptr          pps;
-    H264SeiSyntax::ptr          sei;
+    H264SeiSyntax::ptr          sei;    // the first message of seis
+    std::vector<H264SeiSyntax::ptr> seis;
     H264SliceHeaderSyntax::ptr  slice;
 };
 
+/**
+ * @brief bytes of a parameter set nal unit after the nal unit header, to tell byte identical repeats
+ */
+class H264ParameterSetBytes
+{
+public:
+    H264ParameterSetBytes();
+    ~H264ParameterSetBytes() = default;
+public:
+    uint64_t             hash;
+    std::vector<uint8_t> bytes;
+};
+
 class H264ContextSyntax
 {
 public:
@@ -972,6 +986,9 @@ public:
     std::unordered_map<int32_t, H264PpsSyntax::ptr> ppsSet;
     H264SpsSyntax::ptr sps;
     H264PpsSyntax::ptr pps;
+public: /* bytes of the parameter sets in spsSet and ppsSet, by id */
+    std::unordered_map<int32_t, H264ParameterSetBytes> spsBytes;
+    std::unordered_map<int32_t, H264ParameterSetBytes> ppsBytes;
 };
 
 class H264RplcContext
@@ -1,7 +1,9 @@
 #include "H264Deserialize.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 
 #include "H264Common.h"
@@ -49,6 +51,214 @@ static std::vector<int32_t> Default_8x8_Inter  = {10, 14, 14, 20, 20, 20, 24, 24
 H264Deserialize::H264Deserialize()
 {
     _contex = std::make_shared<H264ContextSyntax>();
+    _pushIterator = std::make_shared<H26xNalIterator>(MMP_H26X_CODEC_H264);
+    _nalUnitTypeMask = 0xFFFFFFFF;
+}
+
+void H264Deserialize::SetSyntaxArena(const H26xSyntaxArena::ptr& arena)
+{
+    _arena = arena;
+}
+
+void H264Deserialize::SetNalUnitTypeMask(uint32_t mask)
+{
+    _nalUnitTypeMask = mask;
+}
+
+void H264Deserialize::SetSeiPayloadTypeMask(const std::vector<uint64_t>& payloadTypes)
+{
+    _seiPayloadTypeMask.clear();
+    for (const auto& payloadType : payloadTypes)
+    {
+        if (payloadType >= _seiPayloadTypeMask.size())
+        {
+            _seiPayloadTypeMask.resize(payloadType + 1, false);
+        }
+        _seiPayloadTypeMask[payloadType] = true;
+    }
+}
+
+void H264Deserialize::RegisterSeiPayloadHandler(uint64_t payloadType, const SeiPayloadHandler& handler)
+{
+    if (handler)
+    {
+        _seiPayloadHandlers[payloadType] = handler;
+    }
+    else
+    {
+        _seiPayloadHandlers.erase(payloadType);
+    }
+}
+
+bool H264Deserialize::IsNalUnitTypeSubscribed(uint8_t nal_unit_type)
+{
+    // Hint : slices refer to the parameter sets, they can not be skipped
+    if (nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_SPS || nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_PPS)
+    {
+        return true;
+    }
+    return (_nalUnitTypeMask >> (nal_unit_type & 0x1F)) & 0x01;
+}
+
+bool H264Deserialize::IsSeiPayloadTypeSubscribed(uint64_t payloadType)
+{
+    if (!_seiPayloadHandlers.empty() && _seiPayloadHandlers.count(payloadType))
+    {
+        // Hint : handed to the caller instead
+        return false;
+    }
+    if (_seiPayloadTypeMask.empty())
+    {
+        return _seiPayloadHandlers.empty();
+    }
+    return payloadType < _seiPayloadTypeMask.size() && _seiPayloadTypeMask[payloadType];
+}
+
+int32_t H264Deserialize::FindParameterSet(const H26xBinaryReader::ptr& br, const std::unordered_map<int32_t, H264ParameterSetBytes>& parameterSetBytes, H264ParameterSetBytes& psBytes)
+{
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    psBytes.hash = 0;
+    psBytes.bytes.clear();
+    if (!br->PeekNalUnitBytes(data, size) || size == 0)
+    {
+        return -1;
+    }
+    psBytes.hash = HashBytes(data, size);
+    for (const auto& parameterSet : parameterSetBytes)
+    {
+        if (parameterSet.second.hash == psBytes.hash && parameterSet.second.bytes.size() == size &&
+            memcmp(parameterSet.second.bytes.data(), data, size) == 0
+        )
+        {
+            return parameterSet.first;
+        }
+    }
+    psBytes.bytes.assign(data, data + size);
+    return -1;
+}
+
+void H264Deserialize::Feed(const uint8_t* data, size_t size)
+{
+    _pushIterator->Feed(data, size);
+}
+
+void H264Deserialize::Flush()
+{
+    _pushIterator->Flush();
+}
+
+bool H264Deserialize::Poll(const H264NalSyntax::ptr& nal)
+{
+    H26xNalUnitView view;
+    while (_pushIterator->Next(view))
+    {
+        if (!IsNalUnitTypeSubscribed(view.nal_unit_type))
+        {
+            // Hint : the nal unit header is already known from the view, no reader is needed
+            nal->nal_ref_idc = view.nal_ref_idc;
+            nal->nal_unit_type = view.nal_unit_type;
+            return true;
+        }
+        // Hint : the nal unit is complete, parse it in place with its size known
+        H26xBinaryReader::ptr br = std::make_shared<H26xBinaryReader>(view.data, view.size);
+        br->SetNalUnitSize(view.size);
+        if (DeserializeNalSyntax(br, nal))
+        {
+            return true;
+        }
+        *nal = H264NalSyntax();
+    }
+    return false;
+}
+
+bool H264Deserialize::DeserializeByteStreamParallel(const uint8_t* data, size_t size, std::vector<H264NalSyntax::ptr>& nals, size_t threads)
+{
+    struct Job
+    {
+        const uint8_t*          data;
+        size_t                  size;
+        H264ContextSyntax::ptr  snapshot;    // nullptr if deserialized in the serial stage
+    };
+    std::vector<Job> jobs;
+    std::vector<H264NalSyntax::ptr> results;
+    std::vector<uint8_t> succeeded;
+    H264ContextSyntax::ptr snapshot = nullptr;
+    // 1 - serial stage, parameter sets are applied to the context in stream order
+    H26xNalIterator iterator(data, size, MMP_H26X_CODEC_H264);
+    H26xNalUnitView view;
+    while (iterator.Next(view))
+    {
+        Job job = {view.data, view.size, nullptr};
+        H264NalSyntax::ptr nal = std::make_shared<H264NalSyntax>();
+        if (view.nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_SPS || view.nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_PPS)
+        {
+            H26xBinaryReader::ptr br = std::make_shared<H26xBinaryReader>(view.data, view.size);
+            br->SetNalUnitSize(view.size);
+            succeeded.push_back(DeserializeNalSyntax(br, nal));
+            snapshot = nullptr;
+        }
+        else
+        {
+            if (!snapshot)
+            {
+                // Hint : never modified since then, shared by the nal units up to the next parameter set
+                snapshot = std::make_shared<H264ContextSyntax>(*_contex);
+            }
+            job.snapshot = snapshot;
+            succeeded.push_back(false);
+        }
+        jobs.push_back(job);
+        results.push_back(nal);
+    }
+    // 2 - parallel stage, each worker deserializes into its own copy of the snapshot
+    threads = std::max<size_t>(threads, 1);
+    if (!_threadPool || _threadPool->Workers() != threads)
+    {
+        _threadPool = std::make_shared<H26xThreadPool>(threads);
+    }
+    _workers.resize(threads);
+    _workerSnapshots.resize(threads);
+    for (auto& worker : _workers)
+    {
+        if (!worker)
+        {
+            worker = std::make_shared<H264Deserialize>();
+        }
+        worker->_nalUnitTypeMask = _nalUnitTypeMask;
+        worker->_seiPayloadTypeMask = _seiPayloadTypeMask;
+        worker->_seiPayloadHandlers = _seiPayloadHandlers;
+    }
+    _threadPool->ParallelFor(jobs.size(), [&](size_t index, size_t worker)
+    {
+        const Job& job = jobs[index];
+        if (!job.snapshot)
+        {
+            return;
+        }
+        if (_workerSnapshots[worker] != job.snapshot)
+        {
+            *_workers[worker]->_contex = *job.snapshot;
+            _workerSnapshots[worker] = job.snapshot;
+        }
+        H26xBinaryReader::ptr br = std::make_shared<H26xBinaryReader>(job.data, job.size);
+        br->SetNalUnitSize(job.size);
+        succeeded[index] = _workers[worker]->DeserializeNalSyntax(br, results[index]);
+    });
+    // 3 - results in stream order
+    bool res = true;
+    for (size_t i=0; i<results.size(); i++)
+    {
+        if (succeeded[i])
+        {
+            nals.push_back(results[i]);
+        }
+        else
+        {
+            res = false;
+        }
+    }
+    return res;
 }
 
 H264Deserialize::~H264Deserialize()
@@ -56,57 +266,23 @@ H264Deserialize::~H264Deserialize()
 
 }
 
-bool H264Deserialize::DeserializeByteStreamNalUnit(H26xBinaryReader::ptr br, H264NalSyntax::ptr nal)
+bool H264Deserialize::DeserializeByteStreamNalUnit(const H26xBinaryReader::ptr& br, const H264NalSyntax::ptr& nal)
 {
     // See also : ISO 14496/10(2020) - B.1.1 Byte stream NAL unit syntax
     try
     {
-        uint32_t next_24_bits = 0;
-        br->U(24, next_24_bits, true);
-        while (next_24_bits != 0x000001)
+        // Hint : leading_zero_8bits and zero_byte are skipped by the start code scanner
+        if (!br->NextStartCode())
         {
-            if ((next_24_bits & 0xFFFF) == 0)
-            {
-                br->Skip(8);
-            }
-            else if ((next_24_bits & 0xFF) == 0)
-            {
-                br->Skip(16);
-            }
-            else
-            {
-                br->Skip(32);
-            }
-            br->U(24, next_24_bits, true);
+            return true;
         }
         br->Skip(24); // start_code_prefix_one_3bytes /* equal to 0x000001 */
         if (!DeserializeNalSyntax(br, nal))
         {
             return false;
         }
-        while (br->more_data_in_byte_stream())
-        {
-            br->U(24, next_24_bits, true);
-            if (next_24_bits != 0x000001)
-            {
-                if ((next_24_bits & 0xFFFF) == 0)
-                {
-                    br->Skip(8);
-                }
-                else if ((next_24_bits & 0xFF) == 0)
-                {
-                    br->Skip(16);
-                }
-                else
-                {
-                    br->Skip(32);
-                }
-            }
-            else
-            {
-                break;
-            }
-        }
+        // Hint : move to the next start code, skip the rest of nal unit and trailing_zero_8bits
+        br->NextStartCode();
         return true;
     }
     catch (const std::out_of_range& /* eof */)
@@ -119,7 +295,37 @@ bool H264Deserialize::DeserializeByteStreamNalUnit(H26xBinaryReader::ptr br, H26
     }
 }
 
-bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSyntax::ptr nal)
+bool H264Deserialize::DeserializeLengthPrefixedNalUnit(const H26xBinaryReader::ptr& br, const H264NalSyntax::ptr& nal, uint8_t lengthSizeMinusOne)
+{
+    // See also : ISO 14496/15 - 5.3.2 AVC sample structure
+    try
+    {
+        MPP_H26X_SYNTAXT_STRICT_CHECK(lengthSizeMinusOne == 0 || lengthSizeMinusOne == 1 || lengthSizeMinusOne == 3, "[nal] lengthSizeMinusOne should be 0, 1 or 3", return false);
+        if (br->Eof())
+        {
+            return true;
+        }
+        uint32_t nalUnitLength = 0;
+        br->U((lengthSizeMinusOne + 1) * 8, nalUnitLength);
+        size_t nalUnitEnd = br->CurBits() + (size_t)nalUnitLength * 8;
+        br->SetNalUnitSize(nalUnitLength);
+        if (!DeserializeNalSyntax(br, nal))
+        {
+            return false;
+        }
+        // Hint : move to the next length prefix, skip the rest of nal unit
+        size_t curBits = br->CurBits();
+        MPP_H26X_SYNTAXT_STRICT_CHECK(curBits <= nalUnitEnd, "[nal] nal unit overruns NALUnitLength", return false);
+        br->Skip(nalUnitEnd - curBits);
+        return !br->HasError();
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool H264Deserialize::DeserializeNalSyntax(const H26xBinaryReader::ptr& br, const H264NalSyntax::ptr& nal)
 {
     // See also : ISO 14496/10(2020) - 7.3.1 NAL unit syntax
     try
@@ -130,6 +336,11 @@ bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSynt
         MPP_H26X_SYNTAXT_STRICT_CHECK(forbidden_zero_bit == 0, "[nal] forbidden_zero_bit should be 0", return false);
         br->U(2, nal->nal_ref_idc);
         br->U(5, nal->nal_unit_type);
+        if (!IsNalUnitTypeSubscribed(nal->nal_unit_type))
+        {
+            br->EndNalUnit();
+            return !br->HasError();
+        }
         if (nal->nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_PREFIX || nal->nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_SLC_EXT ||
             nal->nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_VDRD
         )
@@ -144,7 +355,7 @@ bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSynt
             }
             if (nal->svc_extension_flag)
             {
-                nal->svc = std::make_shared<H264NalSvcSyntax>();
+                nal->svc = MakeSyntax<H264NalSvcSyntax>(_arena);
                 if (!DeserializeNalSvcSyntax(br, nal->svc))
                 {
                     return false;
@@ -152,7 +363,7 @@ bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSynt
             }
             else if (nal->avc_3d_extension_flag)
             {
-                nal->avc = std::make_shared<H264Nal3dAvcSyntax>();
+                nal->avc = MakeSyntax<H264Nal3dAvcSyntax>(_arena);
                 if (!DeserializeNal3dAvcSyntax(br, nal->avc))
                 {
                     return false;
@@ -160,7 +371,7 @@ bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSynt
             }
             else
             {
-                nal->mvc = std::make_shared<H264NalMvcSyntax>();
+                nal->mvc = MakeSyntax<H264NalMvcSyntax>(_arena);
                 if (!DeserializeNalMvcSyntax(br, nal->mvc))
                 {
                     return false;
@@ -171,22 +382,43 @@ bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSynt
         {        
             case H264NaluType::MMP_H264_NALU_TYPE_SPS:
             {
+                // Hint : encoders usually repeat byte identical parameter sets (e.g. before every IDR), reuse the parsed one
+                H264ParameterSetBytes psBytes;
+                int32_t id = FindParameterSet(br, _contex->spsBytes, psBytes);
+                if (id >= 0 && _contex->spsSet.count(id))
+                {
+                    nal->sps = _contex->spsSet[id];
+                    _contex->sps = nal->sps;
+                    break;
+                }
                 nal->sps = std::make_shared<H264SpsSyntax>();
                 if (!DeserializeSpsSyntax(br, nal->sps))
                 {
                     assert(false);
                     return false;
                 }
+                // Hint : PPS is parsed against its SPS, the same bytes may not mean the same now
+                _contex->ppsBytes.clear();
+                _contex->spsBytes[nal->sps->seq_parameter_set_id] = std::move(psBytes);
                 break;
             }
             case H264NaluType::MMP_H264_NALU_TYPE_PPS:
             {
+                H264ParameterSetBytes psBytes;
+                int32_t id = FindParameterSet(br, _contex->ppsBytes, psBytes);
+                if (id >= 0 && _contex->ppsSet.count(id))
+                {
+                    nal->pps = _contex->ppsSet[id];
+                    _contex->pps = nal->pps;
+                    break;
+                }
                 nal->pps = std::make_shared<H264PpsSyntax>();
                 if (!DeserializePpsSyntax(br, nal->pps))
                 {
                     assert(false);
                     return false;
                 }
+                _contex->ppsBytes[nal->pps->pic_parameter_set_id] = std::move(psBytes);
                 break;
             }
             case H264NaluType::MMP_H264_NALU_TYPE_IDR: /* pass through */
@@ -194,7 +426,7 @@ bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSynt
             {
                 // Hint : Slice = Slice header + Slice data + rbsp_trailing_bits()
                 //        only parse slice header and may move to next nal unit
-                nal->slice = std::make_shared<H264SliceHeaderSyntax>();
+                nal->slice = MakeSyntax<H264SliceHeaderSyntax>(_arena);
                 if (!DeserializeSliceHeaderSyntax(br, nal, nal->slice))
                 {
                     assert(false);
@@ -205,12 +437,13 @@ bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSynt
             }
             case H264NaluType::MMP_H264_NALU_TYPE_SEI:
             {
-                nal->sei = std::make_shared<H264SeiSyntax>();
-                if (!DeserializeSeiSyntax(br, nal->sei))
+                nal->seis.clear();
+                if (!DeserializeSeiRbspSyntax(br, nal->seis))
                 {
                     assert(false);
                     return false;
                 }
+                nal->sei = nal->seis.empty() ? nullptr : nal->seis.front();
                 break;
             }
             default:
@@ -219,7 +452,7 @@ bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSynt
                 break;
         }
         br->EndNalUnit();
-        return true;
+        return !br->HasError();
     }
     catch (...)
     {
@@ -227,7 +460,7 @@ bool H264Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSynt
     }
 }
 
-bool H264Deserialize::DeserializeHrdSyntax(H26xBinaryReader::ptr br, H264HrdSyntax::ptr hrd)
+bool H264Deserialize::DeserializeHrdSyntax(const H26xBinaryReader::ptr& br, const H264HrdSyntax::ptr& hrd)
 {
     // See also : ISO 14496/10(2020) - E.1.2 HRD parameters syntax
     try
@@ -256,7 +489,7 @@ bool H264Deserialize::DeserializeHrdSyntax(H26xBinaryReader::ptr br, H264HrdSynt
         br->U(5, hrd->cpb_removal_delay_length_minus1);
         br->U(5, hrd->dpb_output_delay_length_minus1);
         br->U(5, hrd->time_offset_length);
-        return true;
+        return !br->HasError();
     }
     catch (...)
     {
@@ -264,7 +497,7 @@ bool H264Deserialize::DeserializeHrdSyntax(H26xBinaryReader::ptr br, H264HrdSynt
     }
 }
 
-bool H264Deserialize::DeserializeVuiSyntax(H26xBinaryReader::ptr br, H264VuiSyntax::ptr vui)
+bool H264Deserialize::DeserializeVuiSyntax(const H26xBinaryReader::ptr& br, const H264VuiSyntax::ptr& vui)
 {
     constexpr uint8_t Extended_SAR = 255; // Table E-1 – Meaning of sample aspect ratio indicator
 
@@ -402,7 +635,7 @@ bool H264Deserialize::DeserializeVuiSyntax(H26xBinaryReader::ptr br, H264VuiSynt
             br->UE(vui->num_reorder_frames);
             br->UE(vui->max_dec_frame_buffering);
         }
-        return true;
+        return !br->HasError();
     }
     catch (...)
     {
@@ -410,142 +643,187 @@ bool H264Deserialize::DeserializeVuiSyntax(H26xBinaryReader::ptr br, H264VuiSynt
     }
 }
 
-bool H264Deserialize::DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSyntax::ptr sei)
+bool H264Deserialize::DeserializeSeiRbspSyntax(const H26xBinaryReader::ptr& br, std::vector<H264SeiSyntax::ptr>& seis)
 {
-    // See also : ISO 14496/10(2020) - 7.3.2.3.1 Supplemental enhancement information message syntax
+    // See also : ISO 14496/10(2020) - 7.3.2.3 Supplemental enhancement information RBSP syntax
     try
     {
-        uint8_t ff_byte = 0;
         do
         {
-            br->U(8, ff_byte);
-            sei->payloadType += ff_byte;
-        } while (ff_byte == 0xFF);
+            uint64_t payloadType = 0;
+            uint64_t payloadSize = 0;
+            DeserializeSeiPayloadTypeAndSize(br, payloadType, payloadSize);
+            if (!IsSeiPayloadTypeSubscribed(payloadType))
+            {
+                // Hint : no syntax object for the payloads skipped or handed to the caller
+                if (!SkipSeiPayload(br, payloadType, payloadSize))
+                {
+                    return false;
+                }
+                continue;
+            }
+            H264SeiSyntax::ptr sei = MakeSyntax<H264SeiSyntax>(_arena);
+            sei->payloadType = payloadType;
+            sei->payloadSize = payloadSize;
+            if (!DeserializeSeiPayloadSyntax(br, sei))
+            {
+                return false;
+            }
+            seis.push_back(sei);
+        } while (br->more_rbsp_data());
+        return !br->HasError();
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool H264Deserialize::DeserializeSeiSyntax(const H26xBinaryReader::ptr& br, const H264SeiSyntax::ptr& sei)
+{
+    // See also : ISO 14496/10(2020) - 7.3.2.3.1 Supplemental enhancement information message syntax
+    try
+    {
+        DeserializeSeiPayloadTypeAndSize(br, sei->payloadType, sei->payloadSize);
+        if (!IsSeiPayloadTypeSubscribed(sei->payloadType))
+        {
+            return SkipSeiPayload(br, sei->payloadType, sei->payloadSize);
+        }
+        return DeserializeSeiPayloadSyntax(br, sei);
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
 
-        do
+void H264Deserialize::DeserializeSeiPayloadTypeAndSize(const H26xBinaryReader::ptr& br, uint64_t& payloadType, uint64_t& payloadSize)
+{
+    uint8_t ff_byte = 0;
+    do
+    {
+        br->U(8, ff_byte);
+        payloadType += ff_byte;
+    } while (ff_byte == 0xFF);
+
+    do
+    {
+        br->U(8, ff_byte);
+        payloadSize += ff_byte;
+    } while (ff_byte == 0xFF);
+}
+
+bool H264Deserialize::SkipSeiPayload(const H26xBinaryReader::ptr& br, uint64_t payloadType, uint64_t payloadSize)
+{
+    auto handler = _seiPayloadHandlers.find(payloadType);
+    if (handler != _seiPayloadHandlers.end())
+    {
+        const uint8_t* data = nullptr;
+        if (!br->PeekRbspBytes(payloadSize, data))
         {
-            br->U(8, ff_byte);
-            sei->payloadSize += ff_byte;
-        } while (ff_byte == 0xFF);
+            return false;
+        }
+        handler->second(payloadType, data, payloadSize);
+    }
+    br->Skip(payloadSize * 8);
+    return !br->HasError();
+}
 
+bool H264Deserialize::DeserializeSeiPayloadSyntax(const H26xBinaryReader::ptr& br, const H264SeiSyntax::ptr& sei)
+{
+    // See also : ISO 14496/10(2020) - D.1.1 General SEI message syntax
+    try
+    {
+        // Hint : payloads are parsed from a checkpoint then skipped by payloadSize as a whole, so that
+        //        reserved extension bits and unsupported payload types never misalign the next message
+        bool res = true;
+        br->Checkpoint();
         switch (sei->payloadType) 
         {
-            // See also : ISO 14496/10(2020) - D.1.1 General SEI message syntax
             case H264SeiType::MMP_H264_SEI_BUFFERING_PERIOD:
             {
-                sei->bp = std::make_shared<H264SeiBufferPeriodSyntax>();
-                if (!DeserializeSeiBufferPeriodSyntax(br, sei->bp))
-                {
-                    return false;
-                }
+                sei->bp = MakeSyntax<H264SeiBufferPeriodSyntax>(_arena);
+                res = DeserializeSeiBufferPeriodSyntax(br, sei->bp);
                 break;
             }
             case H264SeiType::MMP_H264_SEI_PIC_TIMING:
             {
                 H264VuiSyntax::ptr vui = _contex->sps && _contex->sps->vui_parameters_present_flag ? _contex->sps->vui_seq_parameters : nullptr;
-                sei->pt = std::make_shared<H264SeiPictureTimingSyntax>();
-                MPP_H26X_SYNTAXT_STRICT_CHECK(vui, "[sei] missing vui", return false);
-                if (!DeserializeSeiPictureTimingSyntax(br, vui, sei->pt))
-                {
-                    return false;
-                }
+                sei->pt = MakeSyntax<H264SeiPictureTimingSyntax>(_arena);
+                MPP_H26X_SYNTAXT_STRICT_CHECK(vui, "[sei] missing vui", res = false; break);
+                res = DeserializeSeiPictureTimingSyntax(br, vui, sei->pt);
                 break;
             }
             case H264SeiType::MMP_H264_SEI_USER_DATA_REGISTERED_ITU_T_T35:
             {
-                sei->udr = std::make_shared<H264SeiUserDataRegisteredSyntax>();
-                if (!DeserializeSeiUserDataRegisteredSyntax(br, (uint32_t)sei->payloadSize, sei->udr))
-                {
-                    return false;
-                }
+                sei->udr = MakeSyntax<H264SeiUserDataRegisteredSyntax>(_arena);
+                res = DeserializeSeiUserDataRegisteredSyntax(br, (uint32_t)sei->payloadSize, sei->udr);
                 break;
             }
             case H264SeiType::MMP_H264_SEI_USER_DATA_UNREGISTERED:
             {
-                sei->udn = std::make_shared<H264SeiUserDataUnregisteredSyntax>();
-                if (!DeserializeSeiUserDataUnregisteredSyntax(br, (uint32_t)sei->payloadSize, sei->udn))
-                {
-                    return false;
-                }
+                sei->udn = MakeSyntax<H264SeiUserDataUnregisteredSyntax>(_arena);
+                res = DeserializeSeiUserDataUnregisteredSyntax(br, (uint32_t)sei->payloadSize, sei->udn);
                 break;
             }
             case H264SeiType::MMP_H264_SEI_RECOVERY_POINT:
             {
-                sei->rp = std::make_shared<H264SeiRecoveryPointSyntax>();
-                if (!DeserializeSeiRecoveryPointSyntax(br, sei->rp))
-                {
-                    return false;
-                }
+                sei->rp = MakeSyntax<H264SeiRecoveryPointSyntax>(_arena);
+                res = DeserializeSeiRecoveryPointSyntax(br, sei->rp);
                 break;
             }
             case H264SeiType::MMP_H264_SEI_CONTENT_LIGHT_LEVEL_INFO:
             {
-                sei->clli = std::make_shared<H264SeiContentLigntLevelInfoSyntax>();
-                if (!DeserializeSeiContentLigntLevelInfoSyntax(br, sei->clli))
-                {
-                    return false;
-                }
+                sei->clli = MakeSyntax<H264SeiContentLigntLevelInfoSyntax>(_arena);
+                res = DeserializeSeiContentLigntLevelInfoSyntax(br, sei->clli);
                 break;
             }
             case H264SeiType::MMP_H264_SEI_DISPLAY_ORIENTATION:
             {
-                sei->dot = std::make_shared<H264SeiDisplayOrientationSyntax>();
-                if (!DeserializeSeiDisplayOrientationSyntax(br, sei->dot))
-                {
-                    return false;
-                }
+                sei->dot = MakeSyntax<H264SeiDisplayOrientationSyntax>(_arena);
+                res = DeserializeSeiDisplayOrientationSyntax(br, sei->dot);
                 break;
             }
             case H264SeiType::MMP_H264_SEI_FILM_GRAIN_CHARACTERISTICS:
             {
-                sei->fg = std::make_shared<H264SeiFilmGrainSyntax>();
-                if (!DeserializeSeiFilmGrainSyntax(br, sei->fg))
-                {
-                    return false;
-                }
+                sei->fg = MakeSyntax<H264SeiFilmGrainSyntax>(_arena);
+                res = DeserializeSeiFilmGrainSyntax(br, sei->fg);
                 break;
             }
             case H264SeiType::MMP_H264_SEI_FRAME_PACKING_ARRANGEMENT:
             {
-                sei->fpa = std::make_shared<H264SeiFramePackingArrangementSyntax>();
-                if (!DeserializeSeiFramePackingArrangementSyntax(br, sei->fpa))
-                {
-                    return false;
-                }
+                sei->fpa = MakeSyntax<H264SeiFramePackingArrangementSyntax>(_arena);
+                res = DeserializeSeiFramePackingArrangementSyntax(br, sei->fpa);
                 break;
             }
             case H264SeiType::MMP_H264_SEI_ALTERNATIVE_TRANSFER_CHARACTERISTICS:
             {
-                sei->atc = std::make_shared<H264SeiAlternativeTransferCharacteristicsSyntax>();
-                if (!DeserializeSeiAlternativeTransferCharacteristicsSyntax(br, sei->atc))
-                {
-                    return false;
-                }
+                sei->atc = MakeSyntax<H264SeiAlternativeTransferCharacteristicsSyntax>(_arena);
+                res = DeserializeSeiAlternativeTransferCharacteristicsSyntax(br, sei->atc);
                 break;
             }
             case H264SeiType::MP_H264_SEI_AMBIENT_VIEWING_ENVIRONMENT:
             {
-                sei->awe = std::make_shared<H264AmbientViewingEnvironmentSyntax>();
-                if (!DeserializeAmbientViewingEnvironmentSyntax(br, sei->awe))
-                {
-                    return false;
-                }
+                sei->awe = MakeSyntax<H264AmbientViewingEnvironmentSyntax>(_arena);
+                res = DeserializeAmbientViewingEnvironmentSyntax(br, sei->awe);
                 break;
             }
             case H264SeiType::MMP_H264_SEI_MASTERING_DISPLAY_COLOUR_VOLUME:
             {
-                sei->mpvc = std::make_shared<H264MasteringDisplayColourVolumeSyntax>();
-                if (!DeserializeSeiMasteringDisplayColourVolumeSyntax(br, sei->mpvc))
-                {
-                    return false;
-                }
+                sei->mpvc = MakeSyntax<H264MasteringDisplayColourVolumeSyntax>(_arena);
+                res = DeserializeSeiMasteringDisplayColourVolumeSyntax(br, sei->mpvc);
                 break;
             }
             default:
-                br->Skip(sei->payloadSize * 8);
                 break;
         }
-        return true;
+        br->Rollback();
+        if (!res)
+        {
+            return false;
+        }
+        br->Skip(sei->payloadSize * 8);
+        return !br->HasError();
     }
     catch (...)
     {
@@ -553,7 +831,7 @@ bool H264Deserialize::DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSynt
     }
 }
 
-bool H264Deserialize::DeserializeSpsSyntax(H26xBinaryReader::ptr br, H264SpsSyntax::ptr sps)
+bool H264Deserialize::DeserializeSpsSyntax(const H26xBinaryReader::ptr& br, const H264SpsSyntax::ptr& sps)
 {
     // See also : ISO 14496/10(2020) - 7.3.2.1.1 Sequence parameter set data syntax
     try
@@ -783,7 +1061,7 @@ bool H264Deserialize::DeserializeSpsSyntax(H26xBinaryReader::ptr br, H264SpsSynt
         FillH264SpsContext(sps);
         _contex->spsSet[sps->seq_parameter_set_id] = sps;
         _contex->sps = sps;
-        return true;
+        return !br->HasError();
     }
     catch (...)
     {
@@ -791,7 +1069,7 @@ bool H264Deserialize::DeserializeSpsSyntax(H26xBinaryReader::ptr br, H264SpsSynt
     }
 }
 
-bool H264Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H264NalSyntax::ptr nal, H264SliceHeaderSyntax::ptr slice)
+bool H264Deserialize::DeserializeSliceHeaderSyntax(const H26xBinaryReader::ptr& br, const H264NalSyntax::ptr& nal, const H264SliceHeaderSyntax::ptr& slice)
 {
     // See aslo : ISO 14496/10(2020) - 7.3.3 Slice header syntax
     try
@@ -887,7 +1165,7 @@ bool H264Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
         }
         else
         {
-            slice->rplm = std::make_shared<H264ReferencePictureListModificationSyntax>();
+            slice->rplm = MakeSyntax<H264ReferencePictureListModificationSyntax>(_arena);
             if (!DeserializeReferencePictureListModificationSyntax(br, slice, slice->rplm))
             {
                 return false;
@@ -897,7 +1175,7 @@ bool H264Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
             (pps->weighted_bipred_idc == 1 && slice->slice_type == H264SliceType::MMP_H264_B_SLICE)
         )
         {
-            slice->pwt = std::make_shared<H264PredictionWeightTableSyntax>();
+            slice->pwt = MakeSyntax<H264PredictionWeightTableSyntax>(_arena);
             if (!DeserializePredictionWeightTableSyntax(br, sps, slice, slice->pwt))
             {
                 return false;
@@ -905,7 +1183,7 @@ bool H264Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
         }
         if (nal->nal_ref_idc != 0)
         {
-            slice->drpm = std::make_shared<H264DecodedReferencePictureMarkingSyntax>();
+            slice->drpm = MakeSyntax<H264DecodedReferencePictureMarkingSyntax>(_arena);
             if (!DeserializeDecodedReferencePictureMarkingSyntax(br, nal, slice->drpm))
             {
                 return false;
@@ -945,7 +1223,7 @@ bool H264Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
             br->U(2, slice->slice_group_change_cycle);
         }
         slice->slice_data_bit_offset = (uint16_t)(br->CurBits() - begin);
-        return true;
+        return !br->HasError();
     }
     catch (...)
     {
@@ -953,7 +1231,7 @@ bool H264Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
     }
 }
 
-bool H264Deserialize::DeserializeDecodedReferencePictureMarkingSyntax(H26xBinaryReader::ptr br, H264NalSyntax::ptr nal, H264DecodedReferencePictureMarkingSyntax::ptr drpm)
+bool H264Deserialize::DeserializeDecodedReferencePictureMarkingSyntax(const H26xBinaryReader::ptr& br, const H264NalSyntax::ptr& nal, const H264DecodedReferencePictureMarkingSyntax::ptr& drpm)
 {
     // See also : ISO 14496/10(2020) - 7.3.3.3 Decoded reference picture marking syntax
     try
@@ -1006,7 +1284,7 @@ bool H264Deserialize::DeserializeDecodedReferencePictureMarkingSyntax(H26xBinary
                 } while (memory_management_control_operation != 0);
             }
         }
-        return true;
+        return !br->HasError();
     }
     catch (...)
     {
@@ -1014,7 +1292,7 @@ bool H264Deserialize::DeserializeDecodedReferencePictureMarkingSyntax(H26xBinary
     }
 }
 
-bool H264Deserialize::DeserializeSubSpsSyntax(H26xBinaryReader::ptr br, H264SpsSyntax::ptr sps, H264SubSpsSyntax::ptr subSps)
+bool H264Deserialize::DeserializeSubSpsSyntax(const H26xBinaryReader::ptr& br, const H264SpsSyntax::ptr& sps, const H264SubSpsSyntax::ptr& subSps)
 {
     // See also : ISO 14496/10(2020) - 7.3.2.1.3 Subset sequence parameter set RBSP syntax
     try
@@ -1069,7 +1347,7 @@ bool H264Deserialize::DeserializeSubSpsSyntax(H26xBinaryReader::ptr br, H264SpsS
         }
         br->U(1, subSps->additional_extension2_flag);
         // TODO
-        return true;
+        return !br->HasError();
     }
     catch (...)
     {
@@ -1077,7 +1355,7 @@ bool H264Deserialize::DeserializeSubSpsSyntax(H26xBinaryReader::ptr br, H264SpsS
     }
 }
 
-bool H264Deserialize::DeserializeSpsMvcSyntax(H26xBinaryReader::ptr br, H264SpsMvcSyntax::ptr mvc)
+bool H264Deserialize::DeserializeSpsMvcSyntax(const H26xBinaryReader::ptr& br, const H264SpsMvcSyntax::ptr& mvc)
 {
     // See also : ISO 14496/10(2020) - G.3.3.2.1.4 Sequence parameter set MVC extension syntax
     try
@@ -1153,7 +1431,7 @@ bool H264Deserialize::DeserializeSpsMvcSyntax(H26xBinaryReader::ptr br, H264SpsM
                 br->UE(mvc->applicable_op_num_views_minus1[i][j]);
             }
         }
-        return true;
+        return !br->HasError();
     }
     catch (...)
     {
@@ -1162,7 +1440,7 @@ bool H264Deserialize::DeserializeSpsMvcSyntax(H26xBinaryReader::ptr br, H264SpsM
     
 }
 
-bool H264Deserialize::DeserializeMvcVuiSyntax(H26xBinaryReader::ptr br, H264MvcVuiSyntax::ptr mvcVui)
+bool H264Deserialize::DeserializeMvcVuiSyntax(const H26xBinaryReader::ptr& br, const H264MvcVuiSyntax::ptr& mvcVui)
 {
     // See also : ISO 14496/10(2020) - G.10.1 MVC VUI parameters extension syntax
     try
@@ -1223,7 +1501,7 @@ bool H264Deserialize::DeserializeMvcVuiSyntax(H26xBinaryReader::ptr br, H264MvcV
             }
             br->U(1, mvcVui->vui_mvc_pic_struct_present_flag[i]);
         }
-        return true;
+        return !br->HasError();
     }
     catch(const std::exception& /* e */)
     {
@@ -1231,7 +1509,7 @@ bool H264Deserialize::DeserializeMvcVuiSyntax(H26xBinaryReader::ptr br, H264MvcV
     }
 }
 
-bool H264Deserialize::DeserializePpsSyntax(H26xBinaryReader::ptr br, H264PpsSyntax::ptr pps)
+bool H264Deserialize::DeserializePpsSyntax(const H26xBinaryReader::ptr& br, const H264PpsSyntax::ptr& pps)
 {
     // See aslo : ISO 14496/10(2020) - 7.3.2.2 Picture parameter set RBSP syntax
     try
@@ -1326,20 +1604,20 @@ bool H264Deserialize::DeserializePpsSyntax(H26xBinaryReader::ptr br, H264PpsSynt
                         }
                     }
                 }
-                br->SE(pps->second_chroma_qp_index_offset);
-                {
-                    // Hint : second_chroma_qp_index_offset specifies the offset that shall be added to QPY and QSY for addressing the table of 
-                    // QPC values for the Cr chroma component. The value of second_chroma_qp_index_offset shall be in the range of −12 to 
-                    // +12, inclusive.
-                    MPP_H26X_SYNTAXT_STRICT_CHECK(pps->second_chroma_qp_index_offset >= -12 && pps->second_chroma_qp_index_offset <= 12, "[sps] second_chroma_qp_index_offset out of range", return false);
-                }
             }
-            else
+            br->SE(pps->second_chroma_qp_index_offset);
             {
-                // Hint : When second_chroma_qp_index_offset is not present, it shall be inferred to be equal to chroma_qp_index_offset
-                pps->second_chroma_qp_index_offset = pps->chroma_qp_index_offset;
+                // Hint : second_chroma_qp_index_offset specifies the offset that shall be added to QPY and QSY for addressing the table of 
+                // QPC values for the Cr chroma component. The value of second_chroma_qp_index_offset shall be in the range of −12 to 
+                // +12, inclusive.
+                MPP_H26X_SYNTAXT_STRICT_CHECK(pps->second_chroma_qp_index_offset >= -12 && pps->second_chroma_qp_index_offset <= 12, "[sps] second_chroma_qp_index_offset out of range", return false);
             }
         }
+        else
+        {
+            // Hint : When second_chroma_qp_index_offset is not present, it shall be inferred to be equal to chroma_qp_index_offset
+            pps->second_chroma_qp_index_offset = pps->chroma_qp_index_offset;
+        }
         if (!pps->pic_scaling_matrix_present_flag)
         {
             pps->ScalingList4x4 = sps->ScalingList4x4;
@@ -1348,7 +1626,7 @@ bool H264Deserialize::DeserializePpsSyntax(H26xBinaryReader::ptr br, H264PpsSynt
         br->rbsp_trailing_bits();
         _contex->ppsSet[pps->pic_parameter_set_id] = pps;
         _contex->pps = pps;
-        return true;
+        return !br->HasError();
     }
     catch (...)
     {
@@ -1356,7 +1634,7 @@ bool H264Deserialize::DeserializePpsSyntax(H26xBinaryReader::ptr br, H264PpsSynt
     }
 }
 
-bool H264Deserialize::DeserializeNalSvcSyntax(H26xBinaryReader::ptr br, H264NalSvcSyntax::ptr svc)
+bool H264Deserialize::DeserializeNalSvcSyntax(const H26xBinaryReader::ptr& br, const H264NalSvcSyntax::ptr& svc)
 {
     // See also : ISO 14496/10(2020) - F.3.3.1.1 NAL unit header SVC extension syntax
     try
@@ -1379,7 +1657,7 @@ bool H264Deserialize::DeserializeNalSvcSyntax(H26xBinaryReader::ptr br, H264NalS
     }
 }
 
-bool H264Deserialize::DeserializeNal3dAvcSyntax(H26xBinaryReader::ptr br, H264Nal3dAvcSyntax::ptr avc)
+bool H264Deserialize::DeserializeNal3dAvcSyntax(const H26xBinaryReader::ptr& br, const H264Nal3dAvcSyntax::ptr& avc)
 {
     // See also : ISO 14496/10(2020) - I.3.3.1.1 NAL unit header 3D-AVC extension syntax
     try
@@ -1398,7 +1676,7 @@ bool H264Deserialize::DeserializeNal3dAvcSyntax(H26xBinaryReader::ptr br, H264Na
     }
 }
 
-bool H264Deserialize::DeserializeNalMvcSyntax(H26xBinaryReader::ptr br, H264NalMvcSyntax::ptr mvc)
+bool H264Deserialize::DeserializeNalMvcSyntax(const H26xBinaryReader::ptr& br, const H264NalMvcSyntax::ptr& mvc)
 {
     // See also : ISO 14496/10(2020) - I.3.3.1.1 NAL unit header 3D-AVC extension syntax
     try
@@ -1419,7 +1697,7 @@ bool H264Deserialize::DeserializeNalMvcSyntax(H26xBinaryReader::ptr br, H264NalM
     
 }
 
-bool H264Deserialize::DeserializeScalingListSyntax(H26xBinaryReader::ptr br, std::vector<int32_t>& scalingList, int32_t sizeOfScalingList, int32_t& useDefaultScalingMatrixFlag)
+bool H264Deserialize::DeserializeScalingListSyntax(const H26xBinaryReader::ptr& br, std::vector<int32_t>& scalingList, int32_t sizeOfScalingList, int32_t& useDefaultScalingMatrixFlag)
 {
     // See aslo : ISO 14496/10(2020) - 7.3.2.1.1.1 Scaling list syntax
     try
@@ -1447,7 +1725,7 @@ bool H264Deserialize::DeserializeScalingListSyntax(H26xBinaryReader::ptr br, std
     }
 }
 
-bool H264Deserialize::DeserializeReferencePictureListModificationSyntax(H26xBinaryReader::ptr br, H264SliceHeaderSyntax::ptr slice, H264ReferencePictureListModificationSyntax::ptr rplm)
+bool H264Deserialize::DeserializeReferencePictureListModificationSyntax(const H26xBinaryReader::ptr& br, const H264SliceHeaderSyntax::ptr& slice, const H264ReferencePictureListModificationSyntax::ptr& rplm)
 {
     // See also : ISO 14496/10(2020) - 7.3.3.1 Reference picture list modification syntax
     try
@@ -1514,7 +1792,7 @@ bool H264Deserialize::DeserializeReferencePictureListModificationSyntax(H26xBina
     }
 }
 
-bool H264Deserialize::DeserializePredictionWeightTableSyntax(H26xBinaryReader::ptr br, H264SpsSyntax::ptr sps, H264SliceHeaderSyntax::ptr slice, H264PredictionWeightTableSyntax::ptr pwt)
+bool H264Deserialize::DeserializePredictionWeightTableSyntax(const H26xBinaryReader::ptr& br, const H264SpsSyntax::ptr& sps, const H264SliceHeaderSyntax::ptr& slice, const H264PredictionWeightTableSyntax::ptr& pwt)
 {
     // See also : ISO 14496/10(2020) - 7.3.3.2 Prediction weight table syntax
     try
@@ -1620,7 +1898,7 @@ bool H264Deserialize::DeserializePredictionWeightTableSyntax(H26xBinaryReader::p
     }
 }
 
-bool H264Deserialize::DeserializeSeiBufferPeriodSyntax(H26xBinaryReader::ptr br, H264SeiBufferPeriodSyntax::ptr bp)
+bool H264Deserialize::DeserializeSeiBufferPeriodSyntax(const H26xBinaryReader::ptr& br, const H264SeiBufferPeriodSyntax::ptr& bp)
 {
     // See also : ISO 14496/10(2020) - D.1.2 Buffering period SEI message syntax
     try
@@ -1688,7 +1966,7 @@ bool H264Deserialize::DeserializeSeiBufferPeriodSyntax(H26xBinaryReader::ptr br,
     }
 }
 
-bool H264Deserialize::DeserializeSeiUserDataRegisteredSyntax(H26xBinaryReader::ptr br, uint32_t payloadSize, H264SeiUserDataRegisteredSyntax::ptr udr)
+bool H264Deserialize::DeserializeSeiUserDataRegisteredSyntax(const H26xBinaryReader::ptr& br, uint32_t payloadSize, const H264SeiUserDataRegisteredSyntax::ptr& udr)
 {
     // See also : ISO 14496/10(2020) - D.1.6 User data registered by ITU-T Rec. T.35 SEI message syntax
     try
@@ -1704,14 +1982,12 @@ bool H264Deserialize::DeserializeSeiUserDataRegisteredSyntax(H26xBinaryReader::p
             br->U(8, udr->itu_t_t35_country_code_extension_byte);
             i = 2;
         }
-        udr->itu_t_t35_payload_byte.resize(payloadSize - i);
-        size_t index = 0;
-        do
+        // Hint : do { itu_t_t35_payload_byte; i++; } while (i < payloadSize), at least one byte
+        udr->itu_t_t35_payload_byte.resize(payloadSize > i ? payloadSize - i : 1);
+        if (!br->ReadBytesRbsp(udr->itu_t_t35_payload_byte.size(), udr->itu_t_t35_payload_byte.data()))
         {
-            br->U(8, udr->itu_t_t35_payload_byte[index]);
-            index++;
-            i++;
-        } while (i<payloadSize);
+            return false;
+        }
         return true;
     }
     catch (...)
@@ -1720,19 +1996,19 @@ bool H264Deserialize::DeserializeSeiUserDataRegisteredSyntax(H26xBinaryReader::p
     }
 }
 
-bool H264Deserialize::DeserializeSeiUserDataUnregisteredSyntax(H26xBinaryReader::ptr br, uint32_t payloadSize, H264SeiUserDataUnregisteredSyntax::ptr udn)
+bool H264Deserialize::DeserializeSeiUserDataUnregisteredSyntax(const H26xBinaryReader::ptr& br, uint32_t payloadSize, const H264SeiUserDataUnregisteredSyntax::ptr& udn)
 {
     // See also : ISO 14496/10(2020) - D.1.7 User data unregistered SEI message syntax
     try
     {
-        for (size_t i=0; i<16; i++)
+        if (!br->ReadBytesRbsp(16, udn->uuid_iso_iec_11578))
         {
-            br->U(8, udn->uuid_iso_iec_11578[i]);
+            return false;
         }
-        udn->user_data_payload_byte.resize(payloadSize - 16);
-        for (uint16_t i=16; i<payloadSize; i++)
+        udn->user_data_payload_byte.resize(payloadSize > 16 ? payloadSize - 16 : 0);
+        if (!br->ReadBytesRbsp(udn->user_data_payload_byte.size(), udn->user_data_payload_byte.data()))
         {
-            br->U(8, udn->user_data_payload_byte[i-16]);
+            return false;
         }
         return true;
     }
@@ -1742,7 +2018,7 @@ bool H264Deserialize::DeserializeSeiUserDataUnregisteredSyntax(H26xBinaryReader:
     }
 }
 
-bool H264Deserialize::DeserializeSeiPictureTimingSyntax(H26xBinaryReader::ptr br, H264VuiSyntax::ptr vui, H264SeiPictureTimingSyntax::ptr pt)
+bool H264Deserialize::DeserializeSeiPictureTimingSyntax(const H26xBinaryReader::ptr& br, const H264VuiSyntax::ptr& vui, const H264SeiPictureTimingSyntax::ptr& pt)
 {
     // See also : ISO 14496/10(2020) - D.1.2 Buffering period SEI message syntax
     try
@@ -1874,7 +2150,7 @@ bool H264Deserialize::DeserializeSeiPictureTimingSyntax(H26xBinaryReader::ptr br
     }
 }
 
-bool H264Deserialize::DeserializeSeiRecoveryPointSyntax(H26xBinaryReader::ptr br, H264SeiRecoveryPointSyntax::ptr pt)
+bool H264Deserialize::DeserializeSeiRecoveryPointSyntax(const H26xBinaryReader::ptr& br, const H264SeiRecoveryPointSyntax::ptr& pt)
 {
     // See also : ISO 14496/10(2020) - D.1.8 Recovery point SEI message syntax
     try
@@ -1891,7 +2167,7 @@ bool H264Deserialize::DeserializeSeiRecoveryPointSyntax(H26xBinaryReader::ptr br
     }
 }
 
-bool H264Deserialize::DeserializeSeiContentLigntLevelInfoSyntax(H26xBinaryReader::ptr br, H264SeiContentLigntLevelInfoSyntax::ptr clli)
+bool H264Deserialize::DeserializeSeiContentLigntLevelInfoSyntax(const H26xBinaryReader::ptr& br, const H264SeiContentLigntLevelInfoSyntax::ptr& clli)
 {
     // See also : ISO 14496/10(2020) - D.1.31 Content light level information SEI message syntax
     try
@@ -1906,7 +2182,7 @@ bool H264Deserialize::DeserializeSeiContentLigntLevelInfoSyntax(H26xBinaryReader
     }
 }
 
-bool H264Deserialize::DeserializeSeiDisplayOrientationSyntax(H26xBinaryReader::ptr br, H264SeiDisplayOrientationSyntax::ptr dot)
+bool H264Deserialize::DeserializeSeiDisplayOrientationSyntax(const H26xBinaryReader::ptr& br, const H264SeiDisplayOrientationSyntax::ptr& dot)
 {
     // See also : ISO 14496/10(2020) - D.1.27 Display orientation SEI message syntax
     try 
@@ -1928,7 +2204,7 @@ bool H264Deserialize::DeserializeSeiDisplayOrientationSyntax(H26xBinaryReader::p
     }
 }
 
-bool H264Deserialize::DeserializeSeiMasteringDisplayColourVolumeSyntax(H26xBinaryReader::ptr br, H264MasteringDisplayColourVolumeSyntax::ptr mdcv)
+bool H264Deserialize::DeserializeSeiMasteringDisplayColourVolumeSyntax(const H26xBinaryReader::ptr& br, const H264MasteringDisplayColourVolumeSyntax::ptr& mdcv)
 {
     // See also : ISO 14496/10(2020) - D.1.29 Mastering display colour volume SEI message syntax
     try 
@@ -1950,7 +2226,7 @@ bool H264Deserialize::DeserializeSeiMasteringDisplayColourVolumeSyntax(H26xBinar
     }
 }
 
-bool H264Deserialize::DeserializeSeiFilmGrainSyntax(H26xBinaryReader::ptr br, H264SeiFilmGrainSyntax::ptr fg)
+bool H264Deserialize::DeserializeSeiFilmGrainSyntax(const H26xBinaryReader::ptr& br, const H264SeiFilmGrainSyntax::ptr& fg)
 {
     // See also : ISO 14496/10(2020) - D.1.21 Film grain characteristics SEI message syntax
     try 
@@ -2009,7 +2285,7 @@ bool H264Deserialize::DeserializeSeiFilmGrainSyntax(H26xBinaryReader::ptr br, H2
     }
 }
 
-bool H264Deserialize::DeserializeSeiFramePackingArrangementSyntax(H26xBinaryReader::ptr br, H264SeiFramePackingArrangementSyntax::ptr fpa)
+bool H264Deserialize::DeserializeSeiFramePackingArrangementSyntax(const H26xBinaryReader::ptr& br, const H264SeiFramePackingArrangementSyntax::ptr& fpa)
 {
     // See also : ISO 14496/10(2020) - D.1.27 Display orientation SEI message syntax
     try
@@ -2046,7 +2322,7 @@ bool H264Deserialize::DeserializeSeiFramePackingArrangementSyntax(H26xBinaryRead
     }
 }
 
-bool H264Deserialize::DeserializeSeiAlternativeTransferCharacteristicsSyntax(H26xBinaryReader::ptr br, H264SeiAlternativeTransferCharacteristicsSyntax::ptr atc)
+bool H264Deserialize::DeserializeSeiAlternativeTransferCharacteristicsSyntax(const H26xBinaryReader::ptr& br, const H264SeiAlternativeTransferCharacteristicsSyntax::ptr& atc)
 {
     // See also : D.1.32 Alternative transfer characteristics SEI message syntax
     try
@@ -2060,7 +2336,7 @@ bool H264Deserialize::DeserializeSeiAlternativeTransferCharacteristicsSyntax(H26
     }
 }
 
-bool H264Deserialize::DeserializeAmbientViewingEnvironmentSyntax(H26xBinaryReader::ptr br, H264AmbientViewingEnvironmentSyntax::ptr awe)
+bool H264Deserialize::DeserializeAmbientViewingEnvironmentSyntax(const H26xBinaryReader::ptr& br, const H264AmbientViewingEnvironmentSyntax::ptr& awe)
 {
     // See also : ISO 14496/10(2020) - D.1.34 Ambient viewing environment SEI message syntax
     try
@@ -9,11 +9,16 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "H264Common.h"
 #include "H26xBinaryReader.h"
+#include "H26xNalIterator.h"
+#include "H26xSyntaxArena.h"
+#include "H26xThreadPool.h"
 
 namespace Mmp
 {
@@ -35,40 +40,144 @@ public:
      * @note The format of NAL units for both packet-oriented transport and byte stream is identical except
      *       that each NAL unit can be preceded by a start code prefix and extra padding bytes in the byte stream format.
      */
-    bool DeserializeByteStreamNalUnit(H26xBinaryReader::ptr br, H264NalSyntax::ptr nal);
-    bool DeserializeNalSyntax(H26xBinaryReader::ptr br, H264NalSyntax::ptr nal);
-    bool DeserializeHrdSyntax(H26xBinaryReader::ptr br, H264HrdSyntax::ptr hrd);
-    bool DeserializeVuiSyntax(H26xBinaryReader::ptr br, H264VuiSyntax::ptr vui);
-    bool DeserializeSeiSyntax(H26xBinaryReader::ptr br, H264SeiSyntax::ptr sei);
-    bool DeserializeSpsSyntax(H26xBinaryReader::ptr br, H264SpsSyntax::ptr sps);
-    bool DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H264NalSyntax::ptr nal, H264SliceHeaderSyntax::ptr slice);
-    bool DeserializeDecodedReferencePictureMarkingSyntax(H26xBinaryReader::ptr br, H264NalSyntax::ptr nal, H264DecodedReferencePictureMarkingSyntax::ptr drpm);
-    bool DeserializeSubSpsSyntax(H26xBinaryReader::ptr br, H264SpsSyntax::ptr sps, H264SubSpsSyntax::ptr subSps);
-    bool DeserializeSpsMvcSyntax(H26xBinaryReader::ptr br, H264SpsMvcSyntax::ptr mvc);
-    bool DeserializeMvcVuiSyntax(H26xBinaryReader::ptr br, H264MvcVuiSyntax::ptr mvcVui);
-    bool DeserializePpsSyntax(H26xBinaryReader::ptr br, H264PpsSyntax::ptr pps);
+    bool DeserializeByteStreamNalUnit(const H26xBinaryReader::ptr& br, const H264NalSyntax::ptr& nal);
+    /**
+     * @brief     nal unit with a length prefix instead of a start code, e.g. samples in MP4 or Matroska
+     * @param[in] lengthSizeMinusOne from AVCDecoderConfigurationRecord, the length prefix is lengthSizeMinusOne + 1 bytes
+     * @note      the extent of the nal unit is known up front, there is no start code scanning
+     */
+    bool DeserializeLengthPrefixedNalUnit(const H26xBinaryReader::ptr& br, const H264NalSyntax::ptr& nal, uint8_t lengthSizeMinusOne = 3);
+    bool DeserializeNalSyntax(const H26xBinaryReader::ptr& br, const H264NalSyntax::ptr& nal);
+    bool DeserializeHrdSyntax(const H26xBinaryReader::ptr& br, const H264HrdSyntax::ptr& hrd);
+    bool DeserializeVuiSyntax(const H26xBinaryReader::ptr& br, const H264VuiSyntax::ptr& vui);
+    /**
+     * @brief     every sei_message() of a SEI nal unit
+     * @param[in] br
+     * @param[out] seis
+     */
+    bool DeserializeSeiRbspSyntax(const H26xBinaryReader::ptr& br, std::vector<H264SeiSyntax::ptr>& seis);
+    bool DeserializeSeiSyntax(const H26xBinaryReader::ptr& br, const H264SeiSyntax::ptr& sei);
+    bool DeserializeSpsSyntax(const H26xBinaryReader::ptr& br, const H264SpsSyntax::ptr& sps);
+    bool DeserializeSliceHeaderSyntax(const H26xBinaryReader::ptr& br, const H264NalSyntax::ptr& nal, const H264SliceHeaderSyntax::ptr& slice);
+    bool DeserializeDecodedReferencePictureMarkingSyntax(const H26xBinaryReader::ptr& br, const H264NalSyntax::ptr& nal, const H264DecodedReferencePictureMarkingSyntax::ptr& drpm);
+    bool DeserializeSubSpsSyntax(const H26xBinaryReader::ptr& br, const H264SpsSyntax::ptr& sps, const H264SubSpsSyntax::ptr& subSps);
+    bool DeserializeSpsMvcSyntax(const H26xBinaryReader::ptr& br, const H264SpsMvcSyntax::ptr& mvc);
+    bool DeserializeMvcVuiSyntax(const H26xBinaryReader::ptr& br, const H264MvcVuiSyntax::ptr& mvcVui);
+    bool DeserializePpsSyntax(const H26xBinaryReader::ptr& br, const H264PpsSyntax::ptr& pps);
+public: /* push mode */
+    /**
+     * @brief     feed Annex B byte stream chunk by chunk as it arrives, e.g. from RTP or TCP
+     * @param[in] data
+     * @param[in] size
+     * @note      bytes are copied, a nal unit may cross the chunks
+     */
+    void Feed(const uint8_t* data, size_t size);
+    /**
+     * @brief no more data, the last nal unit fed is complete
+     */
+    void Flush();
+    /**
+     * @brief      deserialize the next complete nal unit fed
+     * @param[out] nal
+     * @return     false if there is no complete nal unit yet, feed more data (or Flush) then poll again
+     * @note       a nal unit failed to deserialize is dropped, bytes already scanned are never scanned again
+     */
+    bool Poll(const H264NalSyntax::ptr& nal);
+public: /* parallel mode */
+    /**
+     * @brief      deserialize every nal unit of Annex B byte stream in a buffer, e.g. an access unit or a chunk of stream,
+     *             SPS and PPS serially then the other nal units (slice headers, SEI) in parallel
+     * @param[in]  data
+     * @param[in]  size
+     * @param[out] nals in stream order, a nal unit failed to deserialize is dropped
+     * @param[in]  threads number of threads, the calling thread included
+     * @return     false if any nal unit failed to deserialize
+     * @note       a nal unit is deserialized against an immutable snapshot of the context taken after the parameter sets
+     *             in front of it; syntax objects of the parallel stage always come from the heap
+     */
+    bool DeserializeByteStreamParallel(const uint8_t* data, size_t size, std::vector<H264NalSyntax::ptr>& nals, size_t threads);
+public: /* allocation */
+    /**
+     * @brief     allocate the syntax objects of the following nal units from the arena, nullptr (default) for the heap
+     * @param[in] arena e.g. one per access unit, reset once the syntax objects of the access unit are released
+     * @note      parameter sets live in the context beyond the access unit, they always come from the heap
+     */
+    void SetSyntaxArena(const H26xSyntaxArena::ptr& arena);
+public: /* subscription */
+    /**
+     * @brief     nal unit types to deserialize, bit (1 << nal_unit_type), all by default
+     * @param[in] mask
+     * @note      for the others only the nal unit header is deserialized, the rest is skipped without allocation;
+     *            SPS and PPS are always deserialized to keep the context consistent
+     */
+    void SetNalUnitTypeMask(uint32_t mask);
+    /**
+     * @brief     SEI payload types to deserialize, empty for all (default)
+     * @param[in] payloadTypes
+     * @note      the others are skipped by payloadSize without allocation
+     */
+    void SetSeiPayloadTypeMask(const std::vector<uint64_t>& payloadTypes);
+public: /* SEI payload handlers */
+    using SeiPayloadHandler = std::function<void(uint64_t payloadType, const uint8_t* data, size_t size)>;
+    /**
+     * @brief     hand the SEI payloads of a type to the caller, e.g. ITU-T T.35 or unregistered user data
+     * @param[in] payloadType
+     * @param[in] handler called with the RBSP bytes of each payload, valid during the call only; nullptr to remove it
+     * @note      handled payloads are not parsed into H264SeiSyntax; once a handler is registered, the payload types
+     *            without handler are skipped by payloadSize without allocation, unless set by SetSeiPayloadTypeMask;
+     *            with DeserializeByteStreamParallel handlers are called from the worker threads
+     */
+    void RegisterSeiPayloadHandler(uint64_t payloadType, const SeiPayloadHandler& handler);
 private:
-    bool DeserializeNalSvcSyntax(H26xBinaryReader::ptr br, H264NalSvcSyntax::ptr svc);
-    bool DeserializeNal3dAvcSyntax(H26xBinaryReader::ptr br, H264Nal3dAvcSyntax::ptr avc);
-    bool DeserializeNalMvcSyntax(H26xBinaryReader::ptr br, H264NalMvcSyntax::ptr mvc);
-    bool DeserializeScalingListSyntax(H26xBinaryReader::ptr br, std::vector<int32_t>& scalingList, int32_t sizeOfScalingList, int32_t& useDefaultScalingMatrixFlag);
-    bool DeserializeReferencePictureListModificationSyntax(H26xBinaryReader::ptr br, H264SliceHeaderSyntax::ptr slice, H264ReferencePictureListModificationSyntax::ptr rplm);
-    bool DeserializePredictionWeightTableSyntax(H26xBinaryReader::ptr br, H264SpsSyntax::ptr sps, H264SliceHeaderSyntax::ptr slice, H264PredictionWeightTableSyntax::ptr pwt);
+    bool IsNalUnitTypeSubscribed(uint8_t nal_unit_type);
+    bool IsSeiPayloadTypeSubscribed(uint64_t payloadType);
+private:
+    /**
+     * @brief      look up the parameter set byte identical to current nal unit
+     * @param[in]  parameterSetBytes bytes of the parameter sets parsed, by id
+     * @param[out] psBytes bytes of current nal unit, to be saved once it is parsed when there is no match
+     * @return     id of the match, -1 if there is none
+     */
+    int32_t FindParameterSet(const H26xBinaryReader::ptr& br, const std::unordered_map<int32_t, H264ParameterSetBytes>& parameterSetBytes, H264ParameterSetBytes& psBytes);
+private:
+    bool DeserializeNalSvcSyntax(const H26xBinaryReader::ptr& br, const H264NalSvcSyntax::ptr& svc);
+    bool DeserializeNal3dAvcSyntax(const H26xBinaryReader::ptr& br, const H264Nal3dAvcSyntax::ptr& avc);
+    bool DeserializeNalMvcSyntax(const H26xBinaryReader::ptr& br, const H264NalMvcSyntax::ptr& mvc);
+    bool DeserializeScalingListSyntax(const H26xBinaryReader::ptr& br, std::vector<int32_t>& scalingList, int32_t sizeOfScalingList, int32_t& useDefaultScalingMatrixFlag);
+    bool DeserializeReferencePictureListModificationSyntax(const H26xBinaryReader::ptr& br, const H264SliceHeaderSyntax::ptr& slice, const H264ReferencePictureListModificationSyntax::ptr& rplm);
+    bool DeserializePredictionWeightTableSyntax(const H26xBinaryReader::ptr& br, const H264SpsSyntax::ptr& sps, const H264SliceHeaderSyntax::ptr& slice, const H264PredictionWeightTableSyntax::ptr& pwt);
 private: /* SEI */
-    bool DeserializeSeiBufferPeriodSyntax(H26xBinaryReader::ptr br, H264SeiBufferPeriodSyntax::ptr bp);
-    bool DeserializeSeiPictureTimingSyntax(H26xBinaryReader::ptr br, H264VuiSyntax::ptr vui, H264SeiPictureTimingSyntax::ptr pt);
-    bool DeserializeSeiUserDataRegisteredSyntax(H26xBinaryReader::ptr br, uint32_t payloadSize, H264SeiUserDataRegisteredSyntax::ptr udr);
-    bool DeserializeSeiUserDataUnregisteredSyntax(H26xBinaryReader::ptr br, uint32_t payloadSize, H264SeiUserDataUnregisteredSyntax::ptr udn);
-    bool DeserializeSeiRecoveryPointSyntax(H26xBinaryReader::ptr br, H264SeiRecoveryPointSyntax::ptr pt);
-    bool DeserializeSeiContentLigntLevelInfoSyntax(H26xBinaryReader::ptr br, H264SeiContentLigntLevelInfoSyntax::ptr clli);
-    bool DeserializeSeiDisplayOrientationSyntax(H26xBinaryReader::ptr br, H264SeiDisplayOrientationSyntax::ptr dot);
-    bool DeserializeSeiMasteringDisplayColourVolumeSyntax(H26xBinaryReader::ptr br, H264MasteringDisplayColourVolumeSyntax::ptr mdcv);
-    bool DeserializeSeiFilmGrainSyntax(H26xBinaryReader::ptr br, H264SeiFilmGrainSyntax::ptr fg);
-    bool DeserializeSeiFramePackingArrangementSyntax(H26xBinaryReader::ptr br, H264SeiFramePackingArrangementSyntax::ptr fpa);
-    bool DeserializeSeiAlternativeTransferCharacteristicsSyntax(H26xBinaryReader::ptr br, H264SeiAlternativeTransferCharacteristicsSyntax::ptr atc);
-    bool DeserializeAmbientViewingEnvironmentSyntax(H26xBinaryReader::ptr br, H264AmbientViewingEnvironmentSyntax::ptr awe);
+    void DeserializeSeiPayloadTypeAndSize(const H26xBinaryReader::ptr& br, uint64_t& payloadType, uint64_t& payloadSize);
+    bool DeserializeSeiPayloadSyntax(const H26xBinaryReader::ptr& br, const H264SeiSyntax::ptr& sei);
+    /**
+     * @brief skip a payload not deserialized, after handing it to its handler if any
+     */
+    bool SkipSeiPayload(const H26xBinaryReader::ptr& br, uint64_t payloadType, uint64_t payloadSize);
+    bool DeserializeSeiBufferPeriodSyntax(const H26xBinaryReader::ptr& br, const H264SeiBufferPeriodSyntax::ptr& bp);
+    bool DeserializeSeiPictureTimingSyntax(const H26xBinaryReader::ptr& br, const H264VuiSyntax::ptr& vui, const H264SeiPictureTimingSyntax::ptr& pt);
+    bool DeserializeSeiUserDataRegisteredSyntax(const H26xBinaryReader::ptr& br, uint32_t payloadSize, const H264SeiUserDataRegisteredSyntax::ptr& udr);
+    bool DeserializeSeiUserDataUnregisteredSyntax(const H26xBinaryReader::ptr& br, uint32_t payloadSize, const H264SeiUserDataUnregisteredSyntax::ptr& udn);
+    bool DeserializeSeiRecoveryPointSyntax(const H26xBinaryReader::ptr& br, const H264SeiRecoveryPointSyntax::ptr& pt);
+    bool DeserializeSeiContentLigntLevelInfoSyntax(const H26xBinaryReader::ptr& br, const H264SeiContentLigntLevelInfoSyntax::ptr& clli);
+    bool DeserializeSeiDisplayOrientationSyntax(const H26xBinaryReader::ptr& br, const H264SeiDisplayOrientationSyntax::ptr& dot);
+    bool DeserializeSeiMasteringDisplayColourVolumeSyntax(const H26xBinaryReader::ptr& br, const H264MasteringDisplayColourVolumeSyntax::ptr& mdcv);
+    bool DeserializeSeiFilmGrainSyntax(const H26xBinaryReader::ptr& br, const H264SeiFilmGrainSyntax::ptr& fg);
+    bool DeserializeSeiFramePackingArrangementSyntax(const H26xBinaryReader::ptr& br, const H264SeiFramePackingArrangementSyntax::ptr& fpa);
+    bool DeserializeSeiAlternativeTransferCharacteristicsSyntax(const H26xBinaryReader::ptr& br, const H264SeiAlternativeTransferCharacteristicsSyntax::ptr& atc);
+    bool DeserializeAmbientViewingEnvironmentSyntax(const H26xBinaryReader::ptr& br, const H264AmbientViewingEnvironmentSyntax::ptr& awe);
 private:
     H264ContextSyntax::ptr _contex;
+    H26xNalIterator::ptr _pushIterator;
+private: /* parallel mode */
+    H26xThreadPool::ptr _threadPool;
+    std::vector<std::shared_ptr<H264Deserialize>> _workers;
+    std::vector<H264ContextSyntax::ptr> _workerSnapshots;    // snapshot last copied into each worker
+private: /* allocation */
+    H26xSyntaxArena::ptr _arena;
+private: /* subscription */
+    uint32_t _nalUnitTypeMask;
+    std::vector<bool> _seiPayloadTypeMask;
+    std::unordered_map<uint64_t, SeiPayloadHandler> _seiPayloadHandlers;
 };
 
 } // namespace Codec
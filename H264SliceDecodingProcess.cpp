@@ -55,12 +55,12 @@ H264PictureContext::H264PictureContext()
     LongTermPicNum = 0;
 }
 
-static bool PictureIsSecondField(H264PictureContext::ptr picture)
+static bool PictureIsSecondField(const H264PictureContext::ptr& picture)
 {
     return picture->bottom_field_flag == 1;
 }
 
-static H264PictureContext::ptr /* complementary picture */ FindComplementaryPicture(H264PictureContext::cache pictures, H264PictureContext::ptr picture)
+static H264PictureContext::ptr /* complementary picture */ FindComplementaryPicture(const H264PictureContext::cache& pictures, const H264PictureContext::ptr& picture)
 {
     H264PictureContext::ptr compPicture = nullptr;
     if (picture->field_pic_flag == 0)
@@ -92,7 +92,7 @@ static H264PictureContext::ptr /* complementary picture */ FindComplementaryPict
     return compPicture;
 }
 
-static int32_t GetPicNumX(H264SliceHeaderSyntax::ptr slice, uint32_t difference_of_pic_nums_minus1)
+static int32_t GetPicNumX(const H264SliceHeaderSyntax::ptr& slice, uint32_t difference_of_pic_nums_minus1)
 {
     int32_t picNumX = 0;
     {
@@ -115,10 +115,10 @@ static int32_t GetPicNumX(H264SliceHeaderSyntax::ptr slice, uint32_t difference_
     return picNumX;
 }
 
-static H264PictureContext::ptr FindPictureByPicNum(H264PictureContext::cache pictures, int64_t PicNum)
+static H264PictureContext::ptr FindPictureByPicNum(const H264PictureContext::cache& pictures, int64_t PicNum)
 {
     H264PictureContext::ptr picture = nullptr;
-    for (auto _picture : pictures)
+    for (auto& _picture : pictures)
     {
         if (_picture->referenceFlag & H264PictureContext::used_for_short_term_reference )
         {
@@ -133,10 +133,10 @@ static H264PictureContext::ptr FindPictureByPicNum(H264PictureContext::cache pic
     return picture;
 }
 
-static H264PictureContext::ptr FindPictureByLongTermPicNum(H264PictureContext::cache pictures, uint64_t LongTermPicNum)
+static H264PictureContext::ptr FindPictureByLongTermPicNum(const H264PictureContext::cache& pictures, uint64_t LongTermPicNum)
 {
     H264PictureContext::ptr picture = nullptr;
-    for (auto _picture : pictures)
+    for (auto& _picture : pictures)
     {
         if (_picture->referenceFlag & H264PictureContext::used_for_long_term_reference)
         {
@@ -151,9 +151,9 @@ static H264PictureContext::ptr FindPictureByLongTermPicNum(H264PictureContext::c
     return picture;
 }
 
-static void UnMarkUsedForShortTermReference(H264PictureContext::cache pictures, int32_t picNumX)
+static void UnMarkUsedForShortTermReference(const H264PictureContext::cache& pictures, int32_t picNumX)
 {
-    for (auto _picture : pictures)
+    for (auto& _picture : pictures)
     {
         if (_picture->PicNum == picNumX && _picture->referenceFlag & H264PictureContext::used_for_short_term_reference)
         {
@@ -180,9 +180,9 @@ static void UnMarkUsedForShortTermReference(H264PictureContext::cache pictures,
     }
 }
 
-static void UnMarkUsedForLongTermReference(H264PictureContext::cache pictures, uint32_t long_term_pic_num)
+static void UnMarkUsedForLongTermReference(const H264PictureContext::cache& pictures, uint32_t long_term_pic_num)
 {
-    for (auto _picture : pictures)
+    for (auto& _picture : pictures)
     {
         if (long_term_pic_num == _picture->LongTermPicNum)
         {
@@ -210,9 +210,9 @@ static void UnMarkUsedForLongTermReference(H264PictureContext::cache pictures, u
     }
 }
 
-static void UnMarkUsedForReference(H264PictureContext::cache pictures, uint32_t long_term_pic_num)
+static void UnMarkUsedForReference(const H264PictureContext::cache& pictures, uint32_t long_term_pic_num)
 {
-    for (auto _picture : pictures)
+    for (auto& _picture : pictures)
     {
         if (long_term_pic_num == _picture->LongTermPicNum && _picture->referenceFlag & H264PictureContext::used_for_long_term_reference)
         {
@@ -226,9 +226,9 @@ static void UnMarkUsedForReference(H264PictureContext::cache pictures, uint32_t
     }
 }
 
-static void MarkShortTermReferenceToLongTermReference(H264PictureContext::cache pictures, int32_t picNumX, uint32_t long_term_frame_idx)
+static void MarkShortTermReferenceToLongTermReference(const H264PictureContext::cache& pictures, int32_t picNumX, uint32_t long_term_frame_idx)
 {
-    for (auto _picture : pictures)
+    for (auto& _picture : pictures)
     {
         if (_picture->field_pic_flag == 0)
         {
@@ -291,7 +291,7 @@ static int32_t DiffPicOrderCnt(H264PictureContext::ptr picA, H264PictureContext:
  *        order or relative to the first output field of the previous picture, in decoding order, that contains a memory management
  *        control operation that marks all reference pictures as "unused for reference"
  */
-void H264SliceDecodingProcess::DecodingProcessForPictureOrderCount(H264NalSyntax::ptr nal, H264SpsSyntax::ptr sps, H264PpsSyntax::ptr pps, H264SliceHeaderSyntax::ptr slice, uint8_t nal_ref_idc, H264PictureContext::ptr picture)
+void H264SliceDecodingProcess::DecodingProcessForPictureOrderCount(const H264NalSyntax::ptr& nal, const H264SpsSyntax::ptr& sps, const H264PpsSyntax::ptr& pps, const H264SliceHeaderSyntax::ptr& slice, uint8_t nal_ref_idc, const H264PictureContext::ptr& picture)
 {
     if (sps->pic_order_cnt_type > 2)
     {
@@ -332,7 +332,7 @@ void H264SliceDecodingProcess::DecodingProcessForPictureOrderCount(H264NalSyntax
 /**
  * @sa ISO 14496/10(2020) - 8.2.1.1 Decoding process for picture order count type 0
  */
-void H264SliceDecodingProcess::DecodeH264PictureOrderCountType0(H264PictureContext::ptr prevPictrue, H264SpsSyntax::ptr sps, H264PpsSyntax::ptr pps, H264SliceHeaderSyntax::ptr slice, uint8_t nal_ref_idc, H264PictureContext::ptr picture)
+void H264SliceDecodingProcess::DecodeH264PictureOrderCountType0(const H264PictureContext::ptr& prevPictrue, const H264SpsSyntax::ptr& sps, const H264PpsSyntax::ptr& pps, const H264SliceHeaderSyntax::ptr& slice, uint8_t nal_ref_idc, const H264PictureContext::ptr& picture)
 {
     int32_t prevPicOrderCntMsb = 0;
     uint32_t prevPicOrderCntLsb = 0;
@@ -412,7 +412,7 @@ void H264SliceDecodingProcess::DecodeH264PictureOrderCountType0(H264PictureConte
 /**
  * @sa ISO 14496/10(2020) - 8.2.1.2 Decoding process for picture order count type 1 
  */
-void H264SliceDecodingProcess::DecodeH264PictureOrderCountType1(H264PictureContext::ptr prevPictrue, H264NalSyntax::ptr nal, H264SpsSyntax::ptr sps, H264SliceHeaderSyntax::ptr slice, uint8_t nal_ref_idc, H264PictureContext::ptr picture)
+void H264SliceDecodingProcess::DecodeH264PictureOrderCountType1(const H264PictureContext::ptr& prevPictrue, const H264NalSyntax::ptr& nal, const H264SpsSyntax::ptr& sps, const H264SliceHeaderSyntax::ptr& slice, uint8_t nal_ref_idc, const H264PictureContext::ptr& picture)
 {
     uint32_t prevFrameNum = prevPictrue ? prevPictrue->FrameNum : 0;
     int32_t  prevFrameNumOffset = 0;
@@ -514,7 +514,7 @@ void H264SliceDecodingProcess::DecodeH264PictureOrderCountType1(H264PictureConte
 /**
  * @sa ISO 14496/10(2020) - 8.2.1.3 Decoding process for picture order count type 2
  */
-void H264SliceDecodingProcess::DecodeH264PictureOrderCountType2(H264PictureContext::ptr prevPictrue, H264SpsSyntax::ptr sps, H264SliceHeaderSyntax::ptr slice, uint8_t nal_ref_idc, H264PictureContext::ptr picture)
+void H264SliceDecodingProcess::DecodeH264PictureOrderCountType2(const H264PictureContext::ptr& prevPictrue, const H264SpsSyntax::ptr& sps, const H264SliceHeaderSyntax::ptr& slice, uint8_t nal_ref_idc, const H264PictureContext::ptr& picture)
 {
     int64_t FrameNumOffset = 0;
     int64_t tempPicOrderCnt = 0;
@@ -590,7 +590,7 @@ void H264SliceDecodingProcess::DecodeH264PictureOrderCountType2(H264PictureConte
 /**
  * @sa  ISO 14496/10(2020) - 8.2.4 Decoding process for reference picture lists construction
  */
-void H264SliceDecodingProcess::DecodingProcessForReferencePictureListsConstruction(H264SliceHeaderSyntax::ptr slice, H264SpsSyntax::ptr sps, H264PictureContext::cache pictures, H264PictureContext::ptr picture)
+void H264SliceDecodingProcess::DecodingProcessForReferencePictureListsConstruction(const H264SliceHeaderSyntax::ptr& slice, const H264SpsSyntax::ptr& sps, const H264PictureContext::cache& pictures, const H264PictureContext::ptr& picture)
 {
     DecodingProcessForPictureNumbers(slice, sps, pictures, picture);
     InitializationProcessForReferencePictureLists(slice, pictures, picture);
@@ -605,12 +605,12 @@ void H264SliceDecodingProcess::DecodingProcessForReferencePictureListsConstructi
 /**
  * @sa  ISO 14496/10(2020) - 8.2.4.1 Decoding process for picture numbers
  */
-void H264SliceDecodingProcess::DecodingProcessForPictureNumbers(H264SliceHeaderSyntax::ptr slice, H264SpsSyntax::ptr sps, H264PictureContext::cache pictures, H264PictureContext::ptr picture)
+void H264SliceDecodingProcess::DecodingProcessForPictureNumbers(const H264SliceHeaderSyntax::ptr& slice, const H264SpsSyntax::ptr& sps, const H264PictureContext::cache& pictures, const H264PictureContext::ptr& picture)
 {
     // determine FrameNumWrap (8-27)
     {
         uint32_t MaxFrameNum = sps->context->MaxFrameNum;
-        for (auto _picture : pictures)
+        for (auto& _picture : pictures)
         {
             if (_picture->referenceFlag & H264PictureContext::used_for_short_term_reference)
             {
@@ -627,7 +627,7 @@ void H264SliceDecodingProcess::DecodingProcessForPictureNumbers(H264SliceHeaderS
     }
     // determine PicNum and LongTermPicNum
     {
-        for (auto _picture : pictures)
+        for (auto& _picture : pictures)
         {
             if (_picture->field_pic_flag == 0)
             {
@@ -679,7 +679,7 @@ void H264SliceDecodingProcess::DecodingProcessForPictureNumbers(H264SliceHeaderS
 /**
  * @sa  ISO 14496/10(2020) - 8.2.4.2 Initialization process for reference picture lists
  */
-void H264SliceDecodingProcess::InitializationProcessForReferencePictureLists(H264SliceHeaderSyntax::ptr slice, H264PictureContext::cache pictures, H264PictureContext::ptr picture)
+void H264SliceDecodingProcess::InitializationProcessForReferencePictureLists(const H264SliceHeaderSyntax::ptr& slice, const H264PictureContext::cache& pictures, const H264PictureContext::ptr& picture)
 {
     {
         _RefPicList0.clear();
@@ -690,7 +690,7 @@ void H264SliceDecodingProcess::InitializationProcessForReferencePictureLists(H26
     {
         std::vector<H264PictureContext::ptr> shortTermRefPicList; // the highest PicNum value in descending order
         std::vector<H264PictureContext::ptr> longTermRefList;     // the lowest LongTermPicNum value in ascending order
-        for (auto picture : pictures)
+        for (auto& picture : pictures)
         {
             if (picture->referenceFlag & H264PictureContext::used_for_short_term_reference)
             {
@@ -735,7 +735,7 @@ void H264SliceDecodingProcess::InitializationProcessForReferencePictureLists(H26
             std::vector<H264PictureContext::ptr> RefPicList03;    // long term  :  the lowest LongTermPicNum value in ascending order
             {
                 H264PictureContext::ptr minPicture = nullptr;
-                for (auto __picture : _pictures)
+                for (auto& __picture : _pictures)
                 {
                     if (__picture->referenceFlag & H264PictureContext::used_for_short_term_reference)
                     {
@@ -751,7 +751,7 @@ void H264SliceDecodingProcess::InitializationProcessForReferencePictureLists(H26
                 });
             }
             {
-                for (auto __picture : _pictures)
+                for (auto& __picture : _pictures)
                 {
                     if (__picture->referenceFlag & H264PictureContext::used_for_short_term_reference)
                     {
@@ -767,7 +767,7 @@ void H264SliceDecodingProcess::InitializationProcessForReferencePictureLists(H26
                 });
             }
             {
-                for (auto picture : pictures)
+                for (auto& picture : pictures)
                 {
                     if (picture->referenceFlag & H264PictureContext::used_for_long_term_reference)
                     {
@@ -798,7 +798,7 @@ void H264SliceDecodingProcess::InitializationProcessForReferencePictureLists(H26
             std::vector<H264PictureContext::ptr> RefPicList12;    // short term :  others in ascending order
             std::vector<H264PictureContext::ptr> RefPicList13;    // long term  :  the lowest LongTermPicNum value in ascending order
             {
-                for (auto __picture : _pictures)
+                for (auto& __picture : _pictures)
                 {
                     if (__picture->referenceFlag & H264PictureContext::used_for_short_term_reference)
                     {
@@ -815,7 +815,7 @@ void H264SliceDecodingProcess::InitializationProcessForReferencePictureLists(H26
                 });
             }
             {
-                for (auto __picture : _pictures)
+                for (auto& __picture : _pictures)
                 {
                     if (__picture->referenceFlag & H264PictureContext::used_for_short_term_reference)
                     {
@@ -832,7 +832,7 @@ void H264SliceDecodingProcess::InitializationProcessForReferencePictureLists(H26
                 });
             }
             {
-                for (auto picture : pictures)
+                for (auto& picture : pictures)
                 {
                     if (picture->referenceFlag & H264PictureContext::used_for_long_term_reference)
                     {
@@ -937,7 +937,7 @@ void H264SliceDecodingProcess::InitializationProcessForReferencePictureLists(H26
 /**
  * @sa  ISO 14496/10(2020) - 8.2.4.3 Modification process for reference picture lists
  */
-void H264SliceDecodingProcess::ModificationProcessForReferencePictureLists(H264SliceHeaderSyntax::ptr slice, H264SpsSyntax::ptr sps, H264PictureContext::cache pictures, H264PictureContext::ptr picture)
+void H264SliceDecodingProcess::ModificationProcessForReferencePictureLists(const H264SliceHeaderSyntax::ptr& slice, const H264SpsSyntax::ptr& sps, const H264PictureContext::cache& pictures, const H264PictureContext::ptr& picture)
 {
     uint64_t MaxPicNum = 0;
     uint64_t CurrPicNum = 0;
@@ -1083,9 +1083,9 @@ void H264SliceDecodingProcess::ModificationProcessForReferencePictureLists(H264S
             else if (modification_of_pic_nums_idc == 2)
             {
                 uint32_t long_term_pic_num = slice->rplm->modification_of_pic_nums_idcs_datas[index++].long_term_pic_num;
-                auto LongTermPicNumF = [pictures, MaxPicNum, picture](uint32_t cIdx) -> uint32_t
+                auto LongTermPicNumF = [&pictures, MaxPicNum, &picture](uint32_t cIdx) -> uint32_t
                 {
-                    for (auto _picture : pictures)
+                    for (auto& _picture : pictures)
                     {
                         if (_picture->LongTermFrameIdx == cIdx)
                         {
@@ -1209,7 +1209,7 @@ void H264SliceDecodingProcess::ModificationProcessForReferencePictureLists(H264S
 /**
  * @sa ISO 14496/10(2020) - 8.2.5 Decoded reference picture marking process
  */
-void H264SliceDecodingProcess::DecodeReferencePictureMarkingProcess(H264NalSyntax::ptr nal, H264SliceHeaderSyntax::ptr slice, H264SpsSyntax::ptr sps, H264PictureContext::cache pictures, H264PictureContext::ptr picture, uint8_t nal_ref_idc)
+void H264SliceDecodingProcess::DecodeReferencePictureMarkingProcess(const H264NalSyntax::ptr& nal, const H264SliceHeaderSyntax::ptr& slice, const H264SpsSyntax::ptr& sps, const H264PictureContext::cache& pictures, const H264PictureContext::ptr& picture, uint8_t nal_ref_idc)
 {
     // Hint : A decoded picture with nal_ref_idc not equal to 0, referred to as a reference picture, is marked as "used for short-term reference" or "used for long-term reference".
     //        - decoded reference frame : both of its fields are marked the same as the frame
@@ -1224,7 +1224,7 @@ void H264SliceDecodingProcess::DecodeReferencePictureMarkingProcess(H264NalSynta
 /**
  * @sa ISO 14496/10(2020) - 8.2.5.1 Sequence of operations for decoded reference picture marking process 
  */
-void H264SliceDecodingProcess::SequenceOfOperationsForDecodedReferencePictureMarkingProcess(H264NalSyntax::ptr nal, H264SliceHeaderSyntax::ptr slice, H264SpsSyntax::ptr sps, H264PictureContext::cache pictures, H264PictureContext::ptr picture)
+void H264SliceDecodingProcess::SequenceOfOperationsForDecodedReferencePictureMarkingProcess(const H264NalSyntax::ptr& nal, const H264SliceHeaderSyntax::ptr& slice, const H264SpsSyntax::ptr& sps, const H264PictureContext::cache& pictures, const H264PictureContext::ptr& picture)
 {
     if (nal->nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_IDR)
     {
@@ -1261,7 +1261,7 @@ void H264SliceDecodingProcess::SequenceOfOperationsForDecodedReferencePictureMar
 /**
  * @sa ISO 14496/10(2020) - 8.2.5.2 Decoding process for gaps in frame_num
  */
-void H264SliceDecodingProcess::DecodingProcessForGapsInFrameNum(H264SliceHeaderSyntax::ptr slice, H264SpsSyntax::ptr sps, H264PictureContext::ptr picture, uint64_t PrevRefFrameNum)
+void H264SliceDecodingProcess::DecodingProcessForGapsInFrameNum(const H264SliceHeaderSyntax::ptr& slice, const H264SpsSyntax::ptr& sps, const H264PictureContext::ptr& picture, uint64_t PrevRefFrameNum)
 {
 
     uint32_t MaxFrameNum = sps->context->MaxFrameNum;
@@ -1276,7 +1276,7 @@ void H264SliceDecodingProcess::DecodingProcessForGapsInFrameNum(H264SliceHeaderS
 /**
  * @sa ISO 14496/10(2020) - 8.2.5.3 Sliding window decoded reference picture marking process
  */
-void H264SliceDecodingProcess::SlidingWindowDecodedReferencePictureMarkingProcess(H264SliceHeaderSyntax::ptr slice, H264SpsSyntax::ptr sps, H264PictureContext::cache pictures, H264PictureContext::ptr picture)
+void H264SliceDecodingProcess::SlidingWindowDecodedReferencePictureMarkingProcess(const H264SliceHeaderSyntax::ptr& slice, const H264SpsSyntax::ptr& sps, const H264PictureContext::cache& pictures, const H264PictureContext::ptr& picture)
 {
     if (PictureIsSecondField(picture))
     {
@@ -1339,7 +1339,7 @@ void H264SliceDecodingProcess::SlidingWindowDecodedReferencePictureMarkingProces
 /**
  * @sa ISO 14496/10(2020) - 8.2.5.4 Adaptive memory control decoded reference picture marking process 
  */
-void H264SliceDecodingProcess::AdaptiveMemoryControlDecodedReferencePicutreMarkingPorcess(H264SliceHeaderSyntax::ptr slice, H264PictureContext::cache pictures, H264PictureContext::ptr picture)
+void H264SliceDecodingProcess::AdaptiveMemoryControlDecodedReferencePicutreMarkingPorcess(const H264SliceHeaderSyntax::ptr& slice, const H264PictureContext::cache& pictures, const H264PictureContext::ptr& picture)
 {
 #if ENABLE_MMP_SD_DEBUG
     H26x_LOG_INFO << "AdaptiveMemoryControlDecodedReferencePicutreMarkingPorcess BEGIN";
@@ -1420,7 +1420,7 @@ void H264SliceDecodingProcess::AdaptiveMemoryControlDecodedReferencePicutreMarki
                 uint32_t max_long_term_frame_idx_plus1 = slice->drpm->memory_management_control_operations_datas[index++].max_long_term_frame_idx_plus1;
                 int64_t MaxLongTermFrameIdx = max_long_term_frame_idx_plus1 == 0 ? no_long_term_frame_indices : max_long_term_frame_idx_plus1 - 1;
                 MPP_H264_SD_LOG("[MM] mmco(%d) max_long_term_frame_idx_plus1(%d) MaxLongTermFrameIdx(%ld)", memory_management_control_operation, max_long_term_frame_idx_plus1, MaxLongTermFrameIdx);
-                for (auto _picture : pictures)
+                for (auto& _picture : pictures)
                 {
                     if (_picture->referenceFlag & H264PictureContext::used_for_long_term_reference && _picture->LongTermFrameIdx > max_long_term_frame_idx_plus1 - 1)
                     {
@@ -1435,7 +1435,7 @@ void H264SliceDecodingProcess::AdaptiveMemoryControlDecodedReferencePicutreMarki
             case H264MmcoType::MMP_H264_MMOO_5: /* unmark all reference pictures */
             {
                 MPP_H264_SD_LOG("[MM] mmco(%d)", memory_management_control_operation);
-                for (auto _picture : pictures)
+                for (auto& _picture : pictures)
                 {
                     _picture->MaxLongTermFrameIdx = no_long_term_frame_indices;
                     _picture->referenceFlag = H264PictureContext::unused_for_reference;
@@ -1507,7 +1507,7 @@ H264SliceDecodingProcess::~H264SliceDecodingProcess()
 
 }
 
-void H264SliceDecodingProcess::SliceDecodingProcess(H264NalSyntax::ptr nal)
+void H264SliceDecodingProcess::SliceDecodingProcess(const H264NalSyntax::ptr& nal)
 {
     switch (nal->nal_unit_type)
     {
@@ -1622,7 +1622,7 @@ void H264SliceDecodingProcess::OnDecodingEnd()
     }
     _endTasks.clear();
     H264PictureContext::cache pictures;
-    for (auto picture : _pictures)
+    for (auto& picture : _pictures)
     {
         if (picture->referenceFlag & H264PictureContext::used_for_short_term_reference || picture->referenceFlag & H264PictureContext::used_for_long_term_reference)
         {
@@ -65,7 +65,7 @@ public:
     H264SliceDecodingProcess();
     virtual ~H264SliceDecodingProcess();
 public:
-    void SliceDecodingProcess(H264NalSyntax::ptr nal);
+    void SliceDecodingProcess(const H264NalSyntax::ptr& nal);
 public:
     H264PictureContext::ptr GetCurrentPictureContext();
     H264PictureContext::cache GetAllPictures();
@@ -79,21 +79,21 @@ private:
     void OnDecodingBegin();
     void OnDecodingEnd();
 private:
-    void DecodingProcessForPictureOrderCount(H264NalSyntax::ptr nal, H264SpsSyntax::ptr sps, H264PpsSyntax::ptr pps, H264SliceHeaderSyntax::ptr slice, uint8_t nal_ref_idc, H264PictureContext::ptr picture);
-    void DecodeH264PictureOrderCountType0(H264PictureContext::ptr prevPictrue, H264SpsSyntax::ptr sps, H264PpsSyntax::ptr pps, H264SliceHeaderSyntax::ptr slice, uint8_t nal_ref_idc, H264PictureContext::ptr picture);
-    void DecodeH264PictureOrderCountType1(H264PictureContext::ptr prevPictrue, H264NalSyntax::ptr nal, H264SpsSyntax::ptr sps, H264SliceHeaderSyntax::ptr slice, uint8_t nal_ref_idc, H264PictureContext::ptr picture);
-    void DecodeH264PictureOrderCountType2(H264PictureContext::ptr prevPictrue, H264SpsSyntax::ptr sps, H264SliceHeaderSyntax::ptr slice, uint8_t nal_ref_idc, H264PictureContext::ptr picture);
+    void DecodingProcessForPictureOrderCount(const H264NalSyntax::ptr& nal, const H264SpsSyntax::ptr& sps, const H264PpsSyntax::ptr& pps, const H264SliceHeaderSyntax::ptr& slice, uint8_t nal_ref_idc, const H264PictureContext::ptr& picture);
+    void DecodeH264PictureOrderCountType0(const H264PictureContext::ptr& prevPictrue, const H264SpsSyntax::ptr& sps, const H264PpsSyntax::ptr& pps, const H264SliceHeaderSyntax::ptr& slice, uint8_t nal_ref_idc, const H264PictureContext::ptr& picture);
+    void DecodeH264PictureOrderCountType1(const H264PictureContext::ptr& prevPictrue, const H264NalSyntax::ptr& nal, const H264SpsSyntax::ptr& sps, const H264SliceHeaderSyntax::ptr& slice, uint8_t nal_ref_idc, const H264PictureContext::ptr& picture);
+    void DecodeH264PictureOrderCountType2(const H264PictureContext::ptr& prevPictrue, const H264SpsSyntax::ptr& sps, const H264SliceHeaderSyntax::ptr& slice, uint8_t nal_ref_idc, const H264PictureContext::ptr& picture);
 private:
-    void DecodingProcessForReferencePictureListsConstruction(H264SliceHeaderSyntax::ptr slice, H264SpsSyntax::ptr sps, H264PictureContext::cache pictures, H264PictureContext::ptr picture);
-    void DecodingProcessForPictureNumbers(H264SliceHeaderSyntax::ptr slice, H264SpsSyntax::ptr sps, H264PictureContext::cache pictures, H264PictureContext::ptr picture);
-    void InitializationProcessForReferencePictureLists(H264SliceHeaderSyntax::ptr slice, H264PictureContext::cache pictures, H264PictureContext::ptr picture);
-    void ModificationProcessForReferencePictureLists(H264SliceHeaderSyntax::ptr slice, H264SpsSyntax::ptr sps, H264PictureContext::cache pictures, H264PictureContext::ptr picture);
+    void DecodingProcessForReferencePictureListsConstruction(const H264SliceHeaderSyntax::ptr& slice, const H264SpsSyntax::ptr& sps, const H264PictureContext::cache& pictures, const H264PictureContext::ptr& picture);
+    void DecodingProcessForPictureNumbers(const H264SliceHeaderSyntax::ptr& slice, const H264SpsSyntax::ptr& sps, const H264PictureContext::cache& pictures, const H264PictureContext::ptr& picture);
+    void InitializationProcessForReferencePictureLists(const H264SliceHeaderSyntax::ptr& slice, const H264PictureContext::cache& pictures, const H264PictureContext::ptr& picture);
+    void ModificationProcessForReferencePictureLists(const H264SliceHeaderSyntax::ptr& slice, const H264SpsSyntax::ptr& sps, const H264PictureContext::cache& pictures, const H264PictureContext::ptr& picture);
 private:
-    void DecodeReferencePictureMarkingProcess(H264NalSyntax::ptr nal, H264SliceHeaderSyntax::ptr slice, H264SpsSyntax::ptr sps, H264PictureContext::cache pictures, H264PictureContext::ptr picture, uint8_t nal_ref_idc);
-    void DecodingProcessForGapsInFrameNum(H264SliceHeaderSyntax::ptr slice, H264SpsSyntax::ptr sps, H264PictureContext::ptr picture, uint64_t PrevRefFrameNum);
-    void SequenceOfOperationsForDecodedReferencePictureMarkingProcess(H264NalSyntax::ptr nal, H264SliceHeaderSyntax::ptr slice, H264SpsSyntax::ptr sps, H264PictureContext::cache pictures, H264PictureContext::ptr picture);
-    void SlidingWindowDecodedReferencePictureMarkingProcess(H264SliceHeaderSyntax::ptr slice, H264SpsSyntax::ptr sps, H264PictureContext::cache pictures, H264PictureContext::ptr picture);
-    void AdaptiveMemoryControlDecodedReferencePicutreMarkingPorcess(H264SliceHeaderSyntax::ptr slice, H264PictureContext::cache pictures, H264PictureContext::ptr picture);
+    void DecodeReferencePictureMarkingProcess(const H264NalSyntax::ptr& nal, const H264SliceHeaderSyntax::ptr& slice, const H264SpsSyntax::ptr& sps, const H264PictureContext::cache& pictures, const H264PictureContext::ptr& picture, uint8_t nal_ref_idc);
+    void DecodingProcessForGapsInFrameNum(const H264SliceHeaderSyntax::ptr& slice, const H264SpsSyntax::ptr& sps, const H264PictureContext::ptr& picture, uint64_t PrevRefFrameNum);
+    void SequenceOfOperationsForDecodedReferencePictureMarkingProcess(const H264NalSyntax::ptr& nal, const H264SliceHeaderSyntax::ptr& slice, const H264SpsSyntax::ptr& sps, const H264PictureContext::cache& pictures, const H264PictureContext::ptr& picture);
+    void SlidingWindowDecodedReferencePictureMarkingProcess(const H264SliceHeaderSyntax::ptr& slice, const H264SpsSyntax::ptr& sps, const H264PictureContext::cache& pictures, const H264PictureContext::ptr& picture);
+    void AdaptiveMemoryControlDecodedReferencePicutreMarkingPorcess(const H264SliceHeaderSyntax::ptr& slice, const H264PictureContext::cache& pictures, const H264PictureContext::ptr& picture);
 private:
     H264PictureContext::ptr _prevPicture;
 private:
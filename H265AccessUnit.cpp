@@ -0,0 +1,136 @@
+#include "H265AccessUnit.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H265AccessUnitAssembler::H265AccessUnitAssembler()
+{
+    _vcl = false;
+}
+
+H265AccessUnit::ptr H265AccessUnitAssembler::Push(const H265NalSyntax::ptr& nal)
+{
+    return Append(nal, nullptr);
+}
+
+H265AccessUnit::ptr H265AccessUnitAssembler::Push(const H265NalSyntax::ptr& nal, const H26xNalUnitView& view)
+{
+    return Append(nal, &view);
+}
+
+H265AccessUnit::ptr H265AccessUnitAssembler::Flush()
+{
+    if (!_au)
+    {
+        return nullptr;
+    }
+    return Emit();
+}
+
+H265AccessUnit::ptr H265AccessUnitAssembler::Append(const H265NalSyntax::ptr& nal, const H26xNalUnitView* view)
+{
+    static const uint8_t kStartCode[4] = {0x00, 0x00, 0x00, 0x01};
+    H265AccessUnit::ptr completed;
+    bool firstOfNext = false;
+    uint8_t nal_unit_type = 0xFF;
+    uint8_t nuh_layer_id = 0;
+    if (nal->header)
+    {
+        nal_unit_type = nal->header->nal_unit_type;
+        nuh_layer_id = nal->header->nuh_layer_id;
+    }
+    else if (view)
+    {
+        nal_unit_type = view->nal_unit_type;
+        nuh_layer_id = view->nuh_layer_id;
+    }
+    // See also : ITU-T H.265 (2021) - 7.4.2.4.4 Order of NAL units and coded pictures and their association to access units
+    // Hint : nal units of the other layers belong to the access unit of the base layer picture
+    if (nal_unit_type <= 31 /* vcl */)
+    {
+        firstOfNext = _vcl && nuh_layer_id == 0 && IsFirstVclNalUnit(nal, view);
+    }
+    else if (nuh_layer_id == 0)
+    {
+        switch (nal_unit_type)
+        {
+            case H265NaluType::MMP_H265_NALU_TYPE_AUD_NUT:
+            case H265NaluType::MMP_H265_NALU_TYPE_VPS_NUT:
+            case H265NaluType::MMP_H265_NALU_TYPE_SPS_NUT:
+            case H265NaluType::MMP_H265_NALU_TYPE_PPS_NUT:
+            case H265NaluType::MMP_H265_NALU_TYPE_PREFIX_SEI_NUT:
+            case 41: case 42: case 43: case 44: /* reserved */
+            case 48: case 49: case 50: case 51: case 52: case 53: case 54: case 55: /* unspecified */
+            {
+                // Hint : they start an access unit when following the last vcl nal unit of the coded picture,
+                //        suffix SEI and filler data never do
+                firstOfNext = _vcl;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    if (firstOfNext)
+    {
+        completed = Emit();
+    }
+    if (!_au)
+    {
+        _au = std::make_shared<H265AccessUnit>();
+    }
+    _au->nals.push_back(nal);
+    if (view)
+    {
+        size_t startCodeLength = view->startCodeLength == 3 ? 3 : 4;
+        _au->bytes.insert(_au->bytes.end(), kStartCode + 4 - startCodeLength, kStartCode + 4);
+        _au->bytes.insert(_au->bytes.end(), view->data, view->data + view->size);
+        // Hint : bytes may still be reallocated, data is set by Emit
+        _au->views.push_back(*view);
+        _au->views.back().startCodeLength = (uint8_t)startCodeLength;
+        _au->views.back().data = nullptr;
+    }
+    if (nal_unit_type <= 31 /* vcl */)
+    {
+        _vcl = true;
+    }
+    else if (nuh_layer_id == 0 &&
+             (nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_EOS_NUT ||
+              nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_EOB_NUT)
+    )
+    {
+        // Hint : end of sequence and end of bitstream are the last nal units of their access unit
+        completed = Emit();
+    }
+    return completed;
+}
+
+bool H265AccessUnitAssembler::IsFirstVclNalUnit(const H265NalSyntax::ptr& nal, const H26xNalUnitView* view)
+{
+    if (nal->slice)
+    {
+        return nal->slice->first_slice_segment_in_pic_flag;
+    }
+    // Hint : slice segment header not deserialized, e.g. not subscribed
+    return view && ClassifyNalUnit(MMP_H26X_CODEC_H265, view->data, view->size).firstSliceInPicture;
+}
+
+H265AccessUnit::ptr H265AccessUnitAssembler::Emit()
+{
+    H265AccessUnit::ptr au = _au;
+    size_t offset = 0;
+    for (auto& view : au->views)
+    {
+        offset += view.startCodeLength;
+        view.data = au->bytes.data() + offset;
+        offset += view.size;
+    }
+    _au = nullptr;
+    _vcl = false;
+    return au;
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,85 @@
+//
+// H265AccessUnit.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+// 
+
+#pragma once
+
+#include <vector>
+
+#include "H265Common.h"
+#include "H26xNalIterator.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief nal units of one coded picture, in decoding order
+ * @sa    ITU-T H.265 (2021) - 7.4.2.4.4 Order of NAL units and coded pictures and their association to access units
+ */
+class H265AccessUnit
+{
+public:
+    using ptr = std::shared_ptr<H265AccessUnit>;
+public:
+    H265AccessUnit() = default;
+    ~H265AccessUnit() = default;
+public:
+    std::vector<H265NalSyntax::ptr> nals;
+    /**
+     * @note one per nal unit if the nal units are pushed with their views, otherwise empty;
+     *       offset is the one in the source byte stream, data points into bytes
+     */
+    std::vector<H26xNalUnitView>    views;
+    std::vector<uint8_t>            bytes;   // copy of the Annex B byte stream of the access unit, start codes included
+};
+
+/**
+ * @brief group deserialized nal units into access units
+ * @note  an access unit is only known to be complete when the first nal unit of the next one arrives,
+ *        or on end of sequence, end of stream and Flush
+ */
+class H265AccessUnitAssembler
+{
+public:
+    using ptr = std::shared_ptr<H265AccessUnitAssembler>;
+public:
+    H265AccessUnitAssembler();
+    ~H265AccessUnitAssembler() = default;
+public:
+    /**
+     * @brief     push the next nal unit in decoding order
+     * @param[in] nal
+     * @return    the access unit completed by this nal unit, nullptr if none
+     */
+    H265AccessUnit::ptr Push(const H265NalSyntax::ptr& nal);
+    /**
+     * @brief     push the next nal unit in decoding order with its raw bytes, which are copied
+     * @param[in] nal
+     * @param[in] view e.g. from H26xNalIterator, only needs to be valid during the call
+     * @return    the access unit completed by this nal unit, nullptr if none
+     * @note      when the slice header is not deserialized (e.g. not subscribed),
+     *            the picture boundary falls back to first_slice_segment_in_pic_flag decoded from the view
+     */
+    H265AccessUnit::ptr Push(const H265NalSyntax::ptr& nal, const H26xNalUnitView& view);
+    /**
+     * @brief  end of the byte stream
+     * @return the last access unit, nullptr if none
+     */
+    H265AccessUnit::ptr Flush();
+private:
+    H265AccessUnit::ptr Append(const H265NalSyntax::ptr& nal, const H26xNalUnitView* view);
+    bool IsFirstVclNalUnit(const H265NalSyntax::ptr& nal, const H26xNalUnitView* view);
+    H265AccessUnit::ptr Emit();
+private:
+    H265AccessUnit::ptr _au;
+    bool _vcl;          // the access unit in progress has a vcl nal unit
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
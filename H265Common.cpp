@@ -539,6 +539,11 @@ H265NalUnitHeaderSyntax::H265NalUnitHeaderSyntax()
     nuh_temporal_id_plus1 = 0;
 }
 
+H265ParameterSetBytes::H265ParameterSetBytes()
+{
+    hash = 0;
+}
+
 H265ContextSyntax::H265ContextSyntax()
 {
     
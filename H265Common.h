@@ -1107,10 +1107,24 @@ public:
     H265VPSSyntax::ptr           vps;
     H265SpsSyntax::ptr           sps;
     H265PpsSyntax::ptr           pps;
-    H265SeiMessageSyntax::ptr    sei;
+    H265SeiMessageSyntax::ptr    sei;    // the first message of seis
+    std::vector<H265SeiMessageSyntax::ptr> seis;
     H265SliceHeaderSyntax::ptr   slice;
 };
 
+/**
+ * @brief bytes of a parameter set nal unit after the nal unit header, to tell byte identical repeats
+ */
+class H265ParameterSetBytes
+{
+public:
+    H265ParameterSetBytes();
+    ~H265ParameterSetBytes() = default;
+public:
+    uint64_t             hash;
+    std::vector<uint8_t> bytes;
+};
+
 class H265ContextSyntax
 {
 public:
@@ -1122,6 +1136,12 @@ public:
     std::unordered_map<int32_t, H265VPSSyntax::ptr> vpsSet;
     std::unordered_map<int32_t, H265SpsSyntax::ptr> spsSet;
     std::unordered_map<int32_t, H265PpsSyntax::ptr> ppsSet;
+public: /* bytes of the parameter sets in vpsSet, spsSet and ppsSet, by id */
+    std::unordered_map<int32_t, H265ParameterSetBytes> vpsBytes;
+    std::unordered_map<int32_t, H265ParameterSetBytes> spsBytes;
+    std::unordered_map<int32_t, H265ParameterSetBytes> ppsBytes;
+public:
+    H265SpsSyntax::ptr activeSps;    // referred by the last slice, or the last SPS if it came after, for SEI messages
 public:
     std::unordered_map<uint32_t, uint32_t> NumNegativePics;
     std::unordered_map<uint32_t, uint32_t> NumPositivePics;
@@ -5,6 +5,7 @@
 #include <vector>
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <algorithm>
 
 #include "H265Common.h"
@@ -125,12 +126,12 @@ static std::vector<int32_t>  Default_8x8_ScalingListInter = {16, 16, 16, 16, 16,
                                                             41, 41, 54, 54, 54, 71, 71, 91
                                                             };
 
-static uint32_t GetCurrRpsIdx(H265SpsSyntax::ptr sps, H265SliceHeaderSyntax::ptr slice)
+static uint32_t GetCurrRpsIdx(const H265SpsSyntax::ptr& sps, const H265SliceHeaderSyntax::ptr& slice)
 {
     return slice->short_term_ref_pic_set_sps_flag == 1 ? slice->short_term_ref_pic_set_idx : sps->num_short_term_ref_pic_sets;
 }
 
-static uint32_t GetNumPicTotalCurr(uint32_t CurrRpsIdx, H265SpsSyntax::ptr sps, H265PpsSyntax::ptr pps, H265SliceHeaderSyntax::ptr slice, H265ContextSyntax::ptr context) // (7-57)
+static uint32_t GetNumPicTotalCurr(uint32_t CurrRpsIdx, const H265SpsSyntax::ptr& sps, const H265PpsSyntax::ptr& pps, const H265SliceHeaderSyntax::ptr& slice, H265ContextSyntax::ptr context) // (7-57)
 {
     uint32_t NumPicTotalCurr = 0;
     {
@@ -172,59 +173,295 @@ static uint32_t GetNumPicTotalCurr(uint32_t CurrRpsIdx, H265SpsSyntax::ptr sps,
 H265Deserialize::H265Deserialize()
 {
     _contex = std::make_shared<H265ContextSyntax>();
+    _pushIterator = std::make_shared<H26xNalIterator>(MMP_H26X_CODEC_H265);
+    _nalUnitTypeMask = 0xFFFFFFFFFFFFFFFF;
 }
 
-bool H265Deserialize::DeserializeByteStreamNalUnit(H26xBinaryReader::ptr br, H265NalSyntax::ptr nal)
+void H265Deserialize::SetSyntaxArena(const H26xSyntaxArena::ptr& arena)
 {
-    // See also : ITU-T H.265 (2021) - B.2.1 Byte stream NAL unit syntax
-    try
+    _arena = arena;
+}
+
+void H265Deserialize::SetNalUnitTypeMask(uint64_t mask)
+{
+    _nalUnitTypeMask = mask;
+}
+
+void H265Deserialize::SetSeiPayloadTypeMask(const std::vector<uint64_t>& payloadTypes)
+{
+    _seiPayloadTypeMask.clear();
+    for (const auto& payloadType : payloadTypes)
+    {
+        if (payloadType >= _seiPayloadTypeMask.size())
+        {
+            _seiPayloadTypeMask.resize(payloadType + 1, false);
+        }
+        _seiPayloadTypeMask[payloadType] = true;
+    }
+}
+
+void H265Deserialize::RegisterSeiPayloadHandler(uint64_t payloadType, const SeiPayloadHandler& handler)
+{
+    if (handler)
+    {
+        _seiPayloadHandlers[payloadType] = handler;
+    }
+    else
+    {
+        _seiPayloadHandlers.erase(payloadType);
+    }
+}
+
+bool H265Deserialize::IsNalUnitTypeSubscribed(uint8_t nal_unit_type)
+{
+    // Hint : slices refer to the parameter sets, they can not be skipped
+    if (nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_VPS_NUT || nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_SPS_NUT ||
+        nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_PPS_NUT
+    )
+    {
+        return true;
+    }
+    return (_nalUnitTypeMask >> (nal_unit_type & 0x3F)) & 0x01;
+}
+
+bool H265Deserialize::IsSeiPayloadTypeSubscribed(uint64_t payloadType)
+{
+    if (!_seiPayloadHandlers.empty() && _seiPayloadHandlers.count(payloadType))
+    {
+        // Hint : handed to the caller instead
+        return false;
+    }
+    if (_seiPayloadTypeMask.empty())
+    {
+        return _seiPayloadHandlers.empty();
+    }
+    return payloadType < _seiPayloadTypeMask.size() && _seiPayloadTypeMask[payloadType];
+}
+
+int32_t H265Deserialize::FindParameterSet(const H26xBinaryReader::ptr& br, const std::unordered_map<int32_t, H265ParameterSetBytes>& parameterSetBytes, H265ParameterSetBytes& psBytes)
+{
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    psBytes.hash = 0;
+    psBytes.bytes.clear();
+    if (!br->PeekNalUnitBytes(data, size) || size == 0)
+    {
+        return -1;
+    }
+    psBytes.hash = HashBytes(data, size);
+    for (const auto& parameterSet : parameterSetBytes)
     {
-        uint32_t next_24_bits = 0;
-        br->U(24, next_24_bits, true);
-        while (next_24_bits != 0x000001)
+        if (parameterSet.second.hash == psBytes.hash && parameterSet.second.bytes.size() == size &&
+            memcmp(parameterSet.second.bytes.data(), data, size) == 0
+        )
         {
-            if ((next_24_bits & 0xFFFF) == 0)
+            return parameterSet.first;
+        }
+    }
+    psBytes.bytes.assign(data, data + size);
+    return -1;
+}
+
+void H265Deserialize::Feed(const uint8_t* data, size_t size)
+{
+    _pushIterator->Feed(data, size);
+}
+
+void H265Deserialize::Flush()
+{
+    _pushIterator->Flush();
+}
+
+bool H265Deserialize::Poll(const H265NalSyntax::ptr& nal)
+{
+    H26xNalUnitView view;
+    while (_pushIterator->Next(view))
+    {
+        if (!IsNalUnitTypeSubscribed(view.nal_unit_type))
+        {
+            // Hint : the nal unit header is already known from the view, no reader is needed
+            if (!nal->header)
             {
-                br->Skip(8);
+                nal->header = MakeSyntax<H265NalUnitHeaderSyntax>(_arena);
             }
-            else if ((next_24_bits & 0xFF) == 0)
+            nal->header->forbidden_zero_bit = 0;
+            nal->header->nal_unit_type = view.nal_unit_type;
+            nal->header->nuh_layer_id = view.nuh_layer_id;
+            nal->header->nuh_temporal_id_plus1 = view.nuh_temporal_id_plus1;
+            return true;
+        }
+        // Hint : the nal unit is complete, parse it in place with its size known
+        H26xBinaryReader::ptr br = std::make_shared<H26xBinaryReader>(view.data, view.size);
+        br->SetNalUnitSize(view.size);
+        if (DeserializeNalSyntax(br, nal))
+        {
+            return true;
+        }
+        *nal = H265NalSyntax();
+    }
+    return false;
+}
+
+bool H265Deserialize::DeserializeByteStreamParallel(const uint8_t* data, size_t size, std::vector<H265NalSyntax::ptr>& nals, size_t threads)
+{
+    struct Job
+    {
+        const uint8_t*          data;
+        size_t                  size;
+        H265ContextSyntax::ptr  snapshot;    // nullptr if deserialized in the serial stage
+        H265SpsSyntax::ptr      activeSps;   // activeSps of the context in front of the nal unit
+    };
+    std::vector<Job> jobs;
+    std::vector<H265NalSyntax::ptr> results;
+    std::vector<uint8_t> succeeded;
+    H265ContextSyntax::ptr snapshot = nullptr;
+    // 1 - serial stage, parameter sets are applied to the context in stream order
+    H26xNalIterator iterator(data, size, MMP_H26X_CODEC_H265);
+    H26xNalUnitView view;
+    while (iterator.Next(view))
+    {
+        Job job = {view.data, view.size, nullptr, nullptr};
+        H265NalSyntax::ptr nal = std::make_shared<H265NalSyntax>();
+        if (view.nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_VPS_NUT || view.nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_SPS_NUT ||
+            view.nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_PPS_NUT
+        )
+        {
+            H26xBinaryReader::ptr br = std::make_shared<H26xBinaryReader>(view.data, view.size);
+            br->SetNalUnitSize(view.size);
+            succeeded.push_back(DeserializeNalSyntax(br, nal));
+            snapshot = nullptr;
+        }
+        else
+        {
+            if (!snapshot)
             {
-                br->Skip(16);
+                // Hint : never modified since then, shared by the nal units up to the next parameter set
+                snapshot = std::make_shared<H265ContextSyntax>(*_contex);
             }
-            else
+            job.snapshot = snapshot;
+            job.activeSps = _contex->activeSps;
+            if (view.nal_unit_type <= H265NaluType::MMP_H265_NALU_TYPE_RSV_IRAP_VCL23)
             {
-                br->Skip(32);
+                // Hint : slices are deserialized in parallel, follow the SPS they refer to for the SEI messages behind them
+                H265SpsSyntax::ptr sps = FindSliceSps(view.data, view.size);
+                if (sps)
+                {
+                    _contex->activeSps = sps;
+                }
             }
-            br->U(24, next_24_bits, true);
+            succeeded.push_back(false);
+        }
+        jobs.push_back(job);
+        results.push_back(nal);
+    }
+    // 2 - parallel stage, each worker deserializes into its own copy of the snapshot
+    threads = std::max<size_t>(threads, 1);
+    if (!_threadPool || _threadPool->Workers() != threads)
+    {
+        _threadPool = std::make_shared<H26xThreadPool>(threads);
+    }
+    _workers.resize(threads);
+    _workerSnapshots.resize(threads);
+    for (auto& worker : _workers)
+    {
+        if (!worker)
+        {
+            worker = std::make_shared<H265Deserialize>();
+        }
+        worker->_nalUnitTypeMask = _nalUnitTypeMask;
+        worker->_seiPayloadTypeMask = _seiPayloadTypeMask;
+        worker->_seiPayloadHandlers = _seiPayloadHandlers;
+    }
+    _threadPool->ParallelFor(jobs.size(), [&](size_t index, size_t worker)
+    {
+        const Job& job = jobs[index];
+        if (!job.snapshot)
+        {
+            return;
+        }
+        if (_workerSnapshots[worker] != job.snapshot)
+        {
+            *_workers[worker]->_contex = *job.snapshot;
+            _workerSnapshots[worker] = job.snapshot;
+        }
+        // Hint : the worker may have run any nal unit of the snapshot before, activeSps depends on the stream order
+        _workers[worker]->_contex->activeSps = job.activeSps;
+        H26xBinaryReader::ptr br = std::make_shared<H26xBinaryReader>(job.data, job.size);
+        br->SetNalUnitSize(job.size);
+        succeeded[index] = _workers[worker]->DeserializeNalSyntax(br, results[index]);
+    });
+    // 3 - results in stream order
+    bool res = true;
+    for (size_t i=0; i<results.size(); i++)
+    {
+        if (succeeded[i])
+        {
+            nals.push_back(results[i]);
+        }
+        else
+        {
+            res = false;
+        }
+    }
+    return res;
+}
+
+H265SpsSyntax::ptr H265Deserialize::FindSliceSps(const uint8_t* data, size_t size)
+{
+    // See also : ITU-T H.265 (2021) - 7.3.6.1 General slice segment header syntax
+    try
+    {
+        H26xBinaryReader::ptr br = std::make_shared<H26xBinaryReader>(data, size);
+        br->SetNalUnitSize(size);
+        br->BeginNalUnit();
+        H265NalUnitHeaderSyntax::ptr header = std::make_shared<H265NalUnitHeaderSyntax>();
+        if (!DeserializeNalHeaderSyntax(br, header))
+        {
+            return nullptr;
+        }
+        uint8_t first_slice_segment_in_pic_flag = 0;
+        uint8_t no_output_of_prior_pics_flag = 0;
+        uint32_t slice_pic_parameter_set_id = 0;
+        br->U(1, first_slice_segment_in_pic_flag);
+        if (header->nal_unit_type >= H265NaluType::MMP_H265_NALU_TYPE_BLA_W_LP && header->nal_unit_type <= H265NaluType::MMP_H265_NALU_TYPE_RSV_IRAP_VCL23)
+        {
+            br->U(1, no_output_of_prior_pics_flag);
+        }
+        br->UE(slice_pic_parameter_set_id);
+        if (br->HasError() || _contex->ppsSet.count(slice_pic_parameter_set_id) == 0)
+        {
+            return nullptr;
+        }
+        H265PpsSyntax::ptr pps = _contex->ppsSet[slice_pic_parameter_set_id];
+        if (_contex->spsSet.count(pps->pps_seq_parameter_set_id) == 0)
+        {
+            return nullptr;
+        }
+        return _contex->spsSet[pps->pps_seq_parameter_set_id];
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+bool H265Deserialize::DeserializeByteStreamNalUnit(const H26xBinaryReader::ptr& br, const H265NalSyntax::ptr& nal)
+{
+    // See also : ITU-T H.265 (2021) - B.2.1 Byte stream NAL unit syntax
+    try
+    {
+        // Hint : leading_zero_8bits and zero_byte are skipped by the start code scanner
+        if (!br->NextStartCode())
+        {
+            return true;
         }
         br->Skip(24); // start_code_prefix_one_3bytes /* equal to 0x000001 */
         if (!DeserializeNalSyntax(br, nal))
         {
             return false;
         }
-        while (br->more_data_in_byte_stream())
-        {
-            br->U(24, next_24_bits, true);
-            if (next_24_bits != 0x000001)
-            {
-                if ((next_24_bits & 0xFFFF) == 0)
-                {
-                    br->Skip(8);
-                }
-                else if ((next_24_bits & 0xFF) == 0)
-                {
-                    br->Skip(16);
-                }
-                else
-                {
-                    br->Skip(32);
-                }
-            }
-            else
-            {
-                break;
-            }
-        }
+        // Hint : move to the next start code, skip the rest of nal unit and trailing_zero_8bits
+        br->NextStartCode();
         return true;
     }
     catch (const std::out_of_range& /* eof */)
@@ -237,48 +474,120 @@ bool H265Deserialize::DeserializeByteStreamNalUnit(H26xBinaryReader::ptr br, H26
     }
 }
 
-bool H265Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H265NalSyntax::ptr nal)
+bool H265Deserialize::DeserializeLengthPrefixedNalUnit(const H26xBinaryReader::ptr& br, const H265NalSyntax::ptr& nal, uint8_t lengthSizeMinusOne)
+{
+    // See also : ISO 14496/15 - 8.3.2 HEVC sample structure
+    try
+    {
+        MPP_H26X_SYNTAXT_STRICT_CHECK(lengthSizeMinusOne == 0 || lengthSizeMinusOne == 1 || lengthSizeMinusOne == 3, "[nal] lengthSizeMinusOne should be 0, 1 or 3", return false);
+        if (br->Eof())
+        {
+            return true;
+        }
+        uint32_t nalUnitLength = 0;
+        br->U((lengthSizeMinusOne + 1) * 8, nalUnitLength);
+        size_t nalUnitEnd = br->CurBits() + (size_t)nalUnitLength * 8;
+        br->SetNalUnitSize(nalUnitLength);
+        if (!DeserializeNalSyntax(br, nal))
+        {
+            return false;
+        }
+        // Hint : move to the next length prefix, skip the rest of nal unit
+        size_t curBits = br->CurBits();
+        MPP_H26X_SYNTAXT_STRICT_CHECK(curBits <= nalUnitEnd, "[nal] nal unit overruns NALUnitLength", return false);
+        br->Skip(nalUnitEnd - curBits);
+        return !br->HasError();
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+bool H265Deserialize::DeserializeNalSyntax(const H26xBinaryReader::ptr& br, const H265NalSyntax::ptr& nal)
 {
     // See also : ITU-T H.265 (2021) - B.2.1 Byte stream NAL unit syntax
     try
     {
         br->BeginNalUnit();
-        nal->header = std::make_shared<H265NalUnitHeaderSyntax>();
+        if (!nal->header)
+        {
+            nal->header = MakeSyntax<H265NalUnitHeaderSyntax>(_arena);
+        }
         if (!DeserializeNalHeaderSyntax(br, nal->header))
         {
             assert(false);
             return false;
         }
+        if (!IsNalUnitTypeSubscribed(nal->header->nal_unit_type))
+        {
+            br->EndNalUnit();
+            return !br->HasError();
+        }
         switch (nal->header->nal_unit_type) 
         {
             case H265NaluType::MMP_H265_NALU_TYPE_VPS_NUT:
             {
+                // Hint : encoders usually repeat byte identical parameter sets (e.g. before every IRAP), reuse the parsed one
+                H265ParameterSetBytes psBytes;
+                int32_t id = FindParameterSet(br, _contex->vpsBytes, psBytes);
+                if (id >= 0 && _contex->vpsSet.count(id))
+                {
+                    nal->vps = _contex->vpsSet[id];
+                    break;
+                }
                 nal->vps = std::make_shared<H265VPSSyntax>();
                 if (!DeserializeVPSSyntax(br, nal->vps))
                 {
                     assert(false);
                     return false;
                 }
+                // Hint : SPS is parsed against its VPS and PPS against its SPS, the same bytes may not mean the same now
+                _contex->spsBytes.clear();
+                _contex->ppsBytes.clear();
+                _contex->vpsBytes[nal->vps->vps_video_parameter_set_id] = std::move(psBytes);
                 break;
             }
             case H265NaluType::MMP_H265_NALU_TYPE_SPS_NUT:
             {
+                H265ParameterSetBytes psBytes;
+                int32_t id = FindParameterSet(br, _contex->spsBytes, psBytes);
+                if (id >= 0 && _contex->spsSet.count(id))
+                {
+                    nal->sps = _contex->spsSet[id];
+                    _contex->activeSps = nal->sps;
+                    break;
+                }
                 nal->sps = std::make_shared<H265SpsSyntax>();
                 if (!DeserializeSpsSyntax(br, nal->sps))
                 {
                     assert(false);
                     return false;
                 }
+                // Hint : the variables derived from st_ref_pic_set() of the SPS (NumDeltaPocs, etc.) are kept in
+                //        the context for the last SPS parsed, so only that one may be reused
+                _contex->spsBytes.clear();
+                _contex->ppsBytes.clear();
+                _contex->spsBytes[nal->sps->sps_seq_parameter_set_id] = std::move(psBytes);
+                _contex->activeSps = nal->sps;
                 break;
             }
             case H265NaluType::MMP_H265_NALU_TYPE_PPS_NUT:
             {
+                H265ParameterSetBytes psBytes;
+                int32_t id = FindParameterSet(br, _contex->ppsBytes, psBytes);
+                if (id >= 0 && _contex->ppsSet.count(id))
+                {
+                    nal->pps = _contex->ppsSet[id];
+                    break;
+                }
                 nal->pps = std::make_shared<H265PpsSyntax>();
                 if (!DeserializePpsSyntax(br, nal->pps))
                 {
                     assert(false);
                     return false;
                 }
+                _contex->ppsBytes[nal->pps->pps_pic_parameter_set_id] = std::move(psBytes);
                 break;
             }
             case H265NaluType::MMP_H265_NALU_TYPE_TRAIL_R:
@@ -298,7 +607,7 @@ bool H265Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H265NalSynt
             case H265NaluType::MMP_H265_NALU_TYPE_RASL_N:
             case H265NaluType::MMP_H265_NALU_TYPE_RASL_R:
             {
-                nal->slice = std::make_shared<H265SliceHeaderSyntax>();
+                nal->slice = MakeSyntax<H265SliceHeaderSyntax>(_arena);
                 if (!DeserializeSliceHeaderSyntax(br, nal->header, nal->slice))
                 {
                     assert(false);
@@ -306,12 +615,24 @@ bool H265Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H265NalSynt
                 }
                 break;
             }
+            case H265NaluType::MMP_H265_NALU_TYPE_PREFIX_SEI_NUT:
+            case H265NaluType::MMP_H265_NALU_TYPE_SUFFIX_SEI_NUT:
+            {
+                nal->seis.clear();
+                if (!DeserializeSeiRbspSyntax(br, nal->header, nal->seis))
+                {
+                    assert(false);
+                    return false;
+                }
+                nal->sei = nal->seis.empty() ? nullptr : nal->seis.front();
+                break;
+            }
             default:
-                assert(false);
+                // Hint : AUD, EOS, EOB, FD and the other nal unit types are not deserialized, the header is enough
                 break;
         }
         br->EndNalUnit();
-        return true;
+        return !br->HasError();
     }
     catch (const std::out_of_range& /* eof */)
     {
@@ -323,7 +644,7 @@ bool H265Deserialize::DeserializeNalSyntax(H26xBinaryReader::ptr br, H265NalSynt
     } 
 }
 
-bool H265Deserialize::DeserializeNalHeaderSyntax(H26xBinaryReader::ptr br, H265NalUnitHeaderSyntax::ptr nalHeader)
+bool H265Deserialize::DeserializeNalHeaderSyntax(const H26xBinaryReader::ptr& br, const H265NalUnitHeaderSyntax::ptr& nalHeader)
 {
     // See also : ITU-T H.265 (2021) - 7.3.1.2 NAL unit header syntax
     try
@@ -332,7 +653,7 @@ bool H265Deserialize::DeserializeNalHeaderSyntax(H26xBinaryReader::ptr br, H265N
         br->U(6, nalHeader->nal_unit_type);
         br->U(6, nalHeader->nuh_layer_id);
         br->U(3, nalHeader->nuh_temporal_id_plus1);
-        return true;
+        return !br->HasError();
     }
     catch (...)
     {
@@ -340,7 +661,7 @@ bool H265Deserialize::DeserializeNalHeaderSyntax(H26xBinaryReader::ptr br, H265N
     } 
 }
 
-bool H265Deserialize::DeserializePpsSyntax(H26xBinaryReader::ptr br, H265PpsSyntax::ptr pps)
+bool H265Deserialize::DeserializePpsSyntax(const H26xBinaryReader::ptr& br, const H265PpsSyntax::ptr& pps)
 {
     // See also : ITU-T H.265 (2021) - 7.3.2.3.1 General picture parameter set RBSP syntax
     try
@@ -514,7 +835,7 @@ bool H265Deserialize::DeserializePpsSyntax(H26xBinaryReader::ptr br, H265PpsSynt
         }
         br->rbsp_trailing_bits();
         _contex->ppsSet[pps->pps_pic_parameter_set_id] = pps;
-        return true;
+        return !br->HasError();
     }
     catch (...)
     {
@@ -522,7 +843,7 @@ bool H265Deserialize::DeserializePpsSyntax(H26xBinaryReader::ptr br, H265PpsSynt
     }
 }
 
-bool H265Deserialize::DeserializeSpsSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps)
+bool H265Deserialize::DeserializeSpsSyntax(const H26xBinaryReader::ptr& br, const H265SpsSyntax::ptr& sps)
 {
     // See also : 7.3.2.2.1 General sequence parameter set RBSP syntax
     try
@@ -728,7 +1049,7 @@ bool H265Deserialize::DeserializeSpsSyntax(H26xBinaryReader::ptr br, H265SpsSynt
         br->rbsp_trailing_bits();
         FillH265SpsContext(sps);
         _contex->spsSet[sps->sps_seq_parameter_set_id] = sps;
-        return true;
+        return !br->HasError();
     }
     catch (...)
     {
@@ -736,7 +1057,7 @@ bool H265Deserialize::DeserializeSpsSyntax(H26xBinaryReader::ptr br, H265SpsSynt
     }
 }
 
-bool H265Deserialize::DeserializeVPSSyntax(H26xBinaryReader::ptr br, H265VPSSyntax::ptr vps)
+bool H265Deserialize::DeserializeVPSSyntax(const H26xBinaryReader::ptr& br, const H265VPSSyntax::ptr& vps)
 {
     // See also : ITU-T H.265 (2021) - 7.3.2.1 Video parameter set RBSP syntax
     try
@@ -846,7 +1167,7 @@ bool H265Deserialize::DeserializeVPSSyntax(H26xBinaryReader::ptr br, H265VPSSynt
         }
         br->rbsp_trailing_bits();
         _contex->vpsSet[vps->vps_video_parameter_set_id] = vps;
-        return true;
+        return !br->HasError();
     }
     catch (...)
     {
@@ -854,105 +1175,210 @@ bool H265Deserialize::DeserializeVPSSyntax(H26xBinaryReader::ptr br, H265VPSSynt
     }
 }
 
-bool H265Deserialize::DeserializeSeiMessageSyntax(H26xBinaryReader::ptr br, H265VPSSyntax::ptr vps, H265SpsSyntax::ptr sps, H265VuiSyntax::ptr vui, H265HrdSyntax::ptr hrd, H265SeiMessageSyntax::ptr sei)
+bool H265Deserialize::DeserializeSeiRbspSyntax(const H26xBinaryReader::ptr& br, const H265NalUnitHeaderSyntax::ptr& nal, std::vector<H265SeiMessageSyntax::ptr>& seis)
 {
-    // See also : 7.3.5 Supplemental enhancement information message syntax
+    // See also : ITU-T H.265 (2021) - 7.3.2.4 Supplemental enhancement information RBSP syntax
     try
     {
-        uint8_t ff_byte = 0;
-        
+        H265SpsSyntax::ptr sps = _contex->activeSps;
+        H265VPSSyntax::ptr vps;
+        H265VuiSyntax::ptr vui;
+        H265HrdSyntax::ptr hrd;
+        if (sps)
+        {
+            if (_contex->vpsSet.count(sps->sps_video_parameter_set_id))
+            {
+                vps = _contex->vpsSet[sps->sps_video_parameter_set_id];
+            }
+            vui = sps->vui;
+            if (vui && vui->vui_hrd_parameters_present_flag)
+            {
+                hrd = vui->hrd_parameters;
+            }
+        }
         do
         {
-            br->U(8, ff_byte);
-            sei->payloadType += ff_byte;
-        } while (ff_byte == 0xFF);
+            uint64_t payloadType = 0;
+            uint64_t payloadSize = 0;
+            DeserializeSeiPayloadTypeAndSize(br, payloadType, payloadSize);
+            if (!IsSeiPayloadTypeSubscribed(payloadType))
+            {
+                // Hint : no syntax object for the payloads skipped or handed to the caller
+                if (!SkipSeiPayload(br, payloadType, payloadSize))
+                {
+                    return false;
+                }
+                continue;
+            }
+            H265SeiMessageSyntax::ptr sei = MakeSyntax<H265SeiMessageSyntax>(_arena);
+            sei->payloadType = payloadType;
+            sei->payloadSize = payloadSize;
+            if (!DeserializeSeiPayloadSyntax(br, nal, vps, sps, vui, hrd, sei))
+            {
+                return false;
+            }
+            seis.push_back(sei);
+        } while (br->more_rbsp_data());
+        return !br->HasError();
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
 
-        do
+bool H265Deserialize::DeserializeSeiMessageSyntax(const H26xBinaryReader::ptr& br, const H265NalUnitHeaderSyntax::ptr& nal, const H265VPSSyntax::ptr& vps, const H265SpsSyntax::ptr& sps, const H265VuiSyntax::ptr& vui, const H265HrdSyntax::ptr& hrd, const H265SeiMessageSyntax::ptr& sei)
+{
+    // See also : 7.3.5 Supplemental enhancement information message syntax
+    try
+    {
+        DeserializeSeiPayloadTypeAndSize(br, sei->payloadType, sei->payloadSize);
+        if (!IsSeiPayloadTypeSubscribed(sei->payloadType))
         {
-            br->U(8, ff_byte);
-            sei->payloadSize += ff_byte;
-        } while (ff_byte == 0xFF);
+            return SkipSeiPayload(br, sei->payloadType, sei->payloadSize);
+        }
+        return DeserializeSeiPayloadSyntax(br, nal, vps, sps, vui, hrd, sei);
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+void H265Deserialize::DeserializeSeiPayloadTypeAndSize(const H26xBinaryReader::ptr& br, uint64_t& payloadType, uint64_t& payloadSize)
+{
+    uint8_t ff_byte = 0;
+    do
+    {
+        br->U(8, ff_byte);
+        payloadType += ff_byte;
+    } while (ff_byte == 0xFF);
 
-        // See also : D.2.1 General SEI message syntax
-        switch (sei->payloadSize) 
+    do
+    {
+        br->U(8, ff_byte);
+        payloadSize += ff_byte;
+    } while (ff_byte == 0xFF);
+}
+
+bool H265Deserialize::SkipSeiPayload(const H26xBinaryReader::ptr& br, uint64_t payloadType, uint64_t payloadSize)
+{
+    auto handler = _seiPayloadHandlers.find(payloadType);
+    if (handler != _seiPayloadHandlers.end())
+    {
+        const uint8_t* data = nullptr;
+        if (!br->PeekRbspBytes(payloadSize, data))
+        {
+            return false;
+        }
+        handler->second(payloadType, data, payloadSize);
+    }
+    br->Skip(payloadSize * 8);
+    return !br->HasError();
+}
+
+bool H265Deserialize::DeserializeSeiPayloadSyntax(const H26xBinaryReader::ptr& br, const H265NalUnitHeaderSyntax::ptr& nal, const H265VPSSyntax::ptr& vps, const H265SpsSyntax::ptr& sps, const H265VuiSyntax::ptr& vui, const H265HrdSyntax::ptr& hrd, const H265SeiMessageSyntax::ptr& sei)
+{
+    // See also : D.2.1 General SEI message syntax
+    try
+    {
+        // Hint : payloads are parsed from a checkpoint then skipped by payloadSize as a whole, so that
+        //        reserved extension bits and unsupported payload types never misalign the next message
+        bool prefix = nal->nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_PREFIX_SEI_NUT;
+        bool res = true;
+        br->Checkpoint();
+        switch (sei->payloadType) 
         {
             case H265SeiPaylodType::MMP_H265_SEI_PIC_TIMING:
             {
-                sei->pt = std::make_shared<H265SeiPicTimingSyntax>();
-                if (!DeserializeSeiPicTimingSyntax(br, sps, vui, hrd, sei->pt))
+                if (!prefix || !sps)
                 {
-                    return false;
+                    break;
                 }
+                sei->pt = MakeSyntax<H265SeiPicTimingSyntax>(_arena);
+                res = DeserializeSeiPicTimingSyntax(br, sps, vui, hrd, sei->pt);
                 break;
             }
             case H265SeiPaylodType::MMP_H265_SEI_RECOVERY_POINT:
             {
-                sei->rp = std::make_shared<H265SeiRecoveryPointSyntax>();
-                if (!DeserializeSeiRecoveryPointSyntax(br, sei->rp))
+                if (!prefix)
                 {
-                    return false;
+                    break;
                 }
+                sei->rp = MakeSyntax<H265SeiRecoveryPointSyntax>(_arena);
+                res = DeserializeSeiRecoveryPointSyntax(br, sei->rp);
                 break;
             }
             case H265SeiPaylodType::MMP_H265_SEI_ACTIVE_PARAMETER_SETS:
             {
-                sei->aps = std::make_shared<H265SeiActiveParameterSetsSyntax>();
-                if (!DeserializeSeiActiveParameterSetsSyntax(br, vps, sei->aps))
+                if (!prefix || !vps)
                 {
-                    assert(false);
+                    break;
                 }
+                sei->aps = MakeSyntax<H265SeiActiveParameterSetsSyntax>(_arena);
+                res = DeserializeSeiActiveParameterSetsSyntax(br, vps, sei->aps);
                 break;
             }
             case H265SeiPaylodType::MMP_H265_SEI_DECODED_PICTURE_HASH:
             {
-                sei->dph = std::make_shared<H265SeiDecodedPictureHashSyntax>();
-                if (!DeserializeSeiDecodedPictureHash(br, sps, sei->dph))
+                if (prefix || !sps)
                 {
-                    return false;
-                }                
+                    break;
+                }
+                sei->dph = MakeSyntax<H265SeiDecodedPictureHashSyntax>(_arena);
+                res = DeserializeSeiDecodedPictureHash(br, sps, sei->dph);
                 break;
             }
             case H265SeiPaylodType::MMP_H265_SEI_TIME_CODE:
             {
-                sei->tc = std::make_shared<H265SeiTimeCodeSyntax>();
-                if (!DeserializeSeiTimeCodeSyntax(br, sei->tc))
+                if (!prefix)
                 {
-                    return false;
+                    break;
                 }
+                sei->tc = MakeSyntax<H265SeiTimeCodeSyntax>(_arena);
+                res = DeserializeSeiTimeCodeSyntax(br, sei->tc);
                 break;
             }
             case H265SeiPaylodType::MMP_H265_SEI_MASTER_DISPLAY_COLOUR_VOLUME:
             {
-                sei->mdcv = std::make_shared<H265MasteringDisplayColourVolumeSyntax>();
-                if (!DeserializeSeiMasteringDisplayColourVolumeSyntax(br, sei->mdcv))
+                if (!prefix)
                 {
-                    return false;
+                    break;
                 }
+                sei->mdcv = MakeSyntax<H265MasteringDisplayColourVolumeSyntax>(_arena);
+                res = DeserializeSeiMasteringDisplayColourVolumeSyntax(br, sei->mdcv);
                 break;
             }
             case H265SeiPaylodType::MMP_H265_SEI_CONTENT_LIGHT_LEVEL_INFORMATION:
             {
-                sei->clli = std::make_shared<H265ContentLightLevelInformationSyntax>();
-                if (!DeserializeSeiContentLightLevelInformationSyntax(br, sei->clli))
+                if (!prefix)
                 {
-                    return false;
+                    break;
                 }
+                sei->clli = MakeSyntax<H265ContentLightLevelInformationSyntax>(_arena);
+                res = DeserializeSeiContentLightLevelInformationSyntax(br, sei->clli);
                 break;
             }
             case H265SeiPaylodType::MMP_H265_SEI_CONTENT_COLOUR_VOLUME:
             {
-                sei->ccv = std::make_shared<H265ContentColourVolumeSyntax>();
-                if (!DeserializeSeiContentColourVolumeSyntax(br, sei->ccv))
+                if (!prefix)
                 {
-                    return false;
+                    break;
                 }
+                sei->ccv = MakeSyntax<H265ContentColourVolumeSyntax>(_arena);
+                res = DeserializeSeiContentColourVolumeSyntax(br, sei->ccv);
                 break;
             }
             default:
-                br->Skip(sei->payloadSize * 8);
                 break;
         }
-        return true;
+        br->Rollback();
+        if (!res)
+        {
+            return false;
+        }
+        br->Skip(sei->payloadSize * 8);
+        return !br->HasError();
     }
     catch (...)
     {
@@ -960,7 +1386,7 @@ bool H265Deserialize::DeserializeSeiMessageSyntax(H26xBinaryReader::ptr br, H265
     }
 }
 
-bool H265Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H265NalUnitHeaderSyntax::ptr nal,  H265SliceHeaderSyntax::ptr slice)
+bool H265Deserialize::DeserializeSliceHeaderSyntax(const H26xBinaryReader::ptr& br, const H265NalUnitHeaderSyntax::ptr& nal, const H265SliceHeaderSyntax::ptr& slice)
 {
     // See also : ITU-T H.265 (2021) - 7.3.6.1 General slice segment header syntax
     try
@@ -990,6 +1416,7 @@ bool H265Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
             return false;
         }
         sps = _contex->spsSet[pps->pps_seq_parameter_set_id];
+        _contex->activeSps = sps;
         if (!slice->first_slice_segment_in_pic_flag)
         {
             if (pps->dependent_slice_segments_enabled_flag)
@@ -1035,7 +1462,7 @@ bool H265Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
                 br->U(1, slice->short_term_ref_pic_set_sps_flag);
                 if (!slice->short_term_ref_pic_set_sps_flag)
                 {
-                    slice->stps = std::make_shared<H265StRefPicSetSyntax>();
+                    slice->stps = MakeSyntax<H265StRefPicSetSyntax>(_arena);
                     if (!DeserializeStRefPicSetSyntax(br, sps, sps->num_short_term_ref_pic_sets, slice->stps))
                     {
                         assert(false);
@@ -1118,7 +1545,7 @@ bool H265Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
                         uint32_t NumPicTotalCurr = GetNumPicTotalCurr(GetCurrRpsIdx(sps, slice), sps, pps, slice, _contex);
                         if (pps->lists_modification_present_flag && NumPicTotalCurr>1)
                         {
-                            slice->rplm = std::make_shared<H265RefPicListsModificationSyntax>();
+                            slice->rplm = MakeSyntax<H265RefPicListsModificationSyntax>(_arena);
                             if (!DeserializeRefPicListsModificationSyntax(br, sps, pps, slice, slice->rplm))
                             {
                                 assert(false);
@@ -1150,7 +1577,7 @@ bool H265Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
                             (pps->weighted_pred_flag && slice->slice_type == H265SliceType::MMP_H265_B_SLICE)
                         )
                         {
-                            slice->pwt = std::make_shared<H265PredWeightTableSyntax>();
+                            slice->pwt = MakeSyntax<H265PredWeightTableSyntax>(_arena);
                             if (!DeserializePredWeightTableSyntax(br, nal, sps, slice, slice->pwt))
                             {
                                 assert(false);
@@ -1213,15 +1640,15 @@ bool H265Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
                 {
                     br->UE(slice->slice_segment_header_extension_length);
                     slice->slice_segment_header_extension_data_byte.resize(slice->slice_segment_header_extension_length);
-                    for (uint32_t i=0; i<slice->slice_segment_header_extension_length; i++)
+                    if (!br->ReadBytesRbsp(slice->slice_segment_header_extension_data_byte.size(), slice->slice_segment_header_extension_data_byte.data()))
                     {
-                        br->U(8, slice->slice_segment_header_extension_data_byte[i]);
+                        return false;
                     }
                 }
                 
             }
         }
-        return true;
+        return !br->HasError();
     }
     catch (...)
     {
@@ -1229,7 +1656,7 @@ bool H265Deserialize::DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H26
     }
 }
 
-bool H265Deserialize::DeserializePps3dSyntax(H26xBinaryReader::ptr br, H265PpsSyntax::ptr pps, H265Pps3dSyntax::ptr pps3d)
+bool H265Deserialize::DeserializePps3dSyntax(const H26xBinaryReader::ptr& br, const H265PpsSyntax::ptr& pps, const H265Pps3dSyntax::ptr& pps3d)
 {
     // See also : ITU-T H.265 (2021) - I.7.3.2.3.7 Picture parameter set 3D extension syntax
     try
@@ -1283,7 +1710,7 @@ bool H265Deserialize::DeserializePps3dSyntax(H26xBinaryReader::ptr br, H265PpsSy
     }
 }
 
-bool H265Deserialize::DeserializePpsRangeSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, H265PpsSyntax::ptr pps, H265PpsRangeSyntax::ptr ppsRange)
+bool H265Deserialize::DeserializePpsRangeSyntax(const H26xBinaryReader::ptr& br, const H265SpsSyntax::ptr& sps, const H265PpsSyntax::ptr& pps, const H265PpsRangeSyntax::ptr& ppsRange)
 {
     // See also : ITU-T H.265 (2021) - 7.3.2.3.2 Picture parameter set range extension syntax
     try
@@ -1360,7 +1787,7 @@ bool H265Deserialize::DeserializePpsRangeSyntax(H26xBinaryReader::ptr br, H265Sp
     }   
 }
 
-bool H265Deserialize::DeserializePpsSccSyntax(H26xBinaryReader::ptr br, H265PpsSccSyntax::ptr ppsScc)
+bool H265Deserialize::DeserializePpsSccSyntax(const H26xBinaryReader::ptr& br, const H265PpsSccSyntax::ptr& ppsScc)
 {
     // See also : ITU-T H.265 (2021) - 7.3.2.3.3 Picture parameter set screen content coding extension syntax
     try
@@ -1420,7 +1847,7 @@ bool H265Deserialize::DeserializePpsSccSyntax(H26xBinaryReader::ptr br, H265PpsS
     }  
 }
 
-bool H265Deserialize::DeserializeSpsRangeSyntax(H26xBinaryReader::ptr br, H265SpsRangeSyntax::ptr spsRange)
+bool H265Deserialize::DeserializeSpsRangeSyntax(const H26xBinaryReader::ptr& br, const H265SpsRangeSyntax::ptr& spsRange)
 {
     // See also : ITU-T H.265 (2021) - 7.3.2.2.2 Sequence parameter set range extension syntax
     try
@@ -1441,7 +1868,7 @@ bool H265Deserialize::DeserializeSpsRangeSyntax(H26xBinaryReader::ptr br, H265Sp
     }
 }
 
-bool H265Deserialize::DeserializeSps3DSyntax(H26xBinaryReader::ptr br, H265Sps3DSyntax::ptr sps3d)
+bool H265Deserialize::DeserializeSps3DSyntax(const H26xBinaryReader::ptr& br, const H265Sps3DSyntax::ptr& sps3d)
 {
     // See also : ITU-T H.265 (2021) - I.7.3.2.2.5 Sequence parameter set 3D extension syntax
     try
@@ -1477,7 +1904,7 @@ bool H265Deserialize::DeserializeSps3DSyntax(H26xBinaryReader::ptr br, H265Sps3D
     }
 }
 
-bool H265Deserialize::DeserializeSpsSccSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, H265SpsSccSyntax::ptr spsScc)
+bool H265Deserialize::DeserializeSpsSccSyntax(const H26xBinaryReader::ptr& br, const H265SpsSyntax::ptr& sps, const H265SpsSccSyntax::ptr& spsScc)
 {
     // See also : ITU-T H.265 (2021) - 7.3.2.2.3 Sequence parameter set screen content coding extension syntax
     try
@@ -1514,7 +1941,7 @@ bool H265Deserialize::DeserializeSpsSccSyntax(H26xBinaryReader::ptr br, H265SpsS
     }
 }
 
-bool H265Deserialize::DeserializeVuiSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, H265VuiSyntax::ptr vui)
+bool H265Deserialize::DeserializeVuiSyntax(const H26xBinaryReader::ptr& br, const H265SpsSyntax::ptr& sps, const H265VuiSyntax::ptr& vui)
 {
     // See also : ITU-T H.265 (2021) - E.2.1 VUI parameters syntax
     try
@@ -1683,7 +2110,7 @@ bool H265Deserialize::DeserializeVuiSyntax(H26xBinaryReader::ptr br, H265SpsSynt
     } 
 }
 
-bool H265Deserialize::DeserializeRefPicListsModificationSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, H265PpsSyntax::ptr pps, H265SliceHeaderSyntax::ptr slice, H265RefPicListsModificationSyntax::ptr rplm)
+bool H265Deserialize::DeserializeRefPicListsModificationSyntax(const H26xBinaryReader::ptr& br, const H265SpsSyntax::ptr& sps, const H265PpsSyntax::ptr& pps, const H265SliceHeaderSyntax::ptr& slice, const H265RefPicListsModificationSyntax::ptr& rplm)
 {
     // See also : ITU-T H.265 (2021) - 7.3.6.2 Reference picture list modification syntax
     try
@@ -1718,7 +2145,7 @@ bool H265Deserialize::DeserializeRefPicListsModificationSyntax(H26xBinaryReader:
     }
 }
 
-bool H265Deserialize::DeserializePredWeightTableSyntax(H26xBinaryReader::ptr br, H265NalUnitHeaderSyntax::ptr header, H265SpsSyntax::ptr sps, H265SliceHeaderSyntax::ptr slice, H265PredWeightTableSyntax::ptr pwt)
+bool H265Deserialize::DeserializePredWeightTableSyntax(const H26xBinaryReader::ptr& br, const H265NalUnitHeaderSyntax::ptr& header, const H265SpsSyntax::ptr& sps, const H265SliceHeaderSyntax::ptr& slice, const H265PredWeightTableSyntax::ptr& pwt)
 {
     // See also : ITU-T H.265 (2021) - 7.3.6.3 Weighted prediction parameters syntax
     try
@@ -1746,7 +2173,7 @@ bool H265Deserialize::DeserializePredWeightTableSyntax(H26xBinaryReader::ptr br,
     }
 }
 
-bool H265Deserialize::DeserializeSeiDecodedPictureHash(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, H265SeiDecodedPictureHashSyntax::ptr dph)
+bool H265Deserialize::DeserializeSeiDecodedPictureHash(const H26xBinaryReader::ptr& br, const H265SpsSyntax::ptr& sps, const H265SeiDecodedPictureHashSyntax::ptr& dph)
 {
     // See also : ITU-T H.265 (2021) - D.2.20 Decoded picture hash SEI message syntax
     try
@@ -1791,18 +2218,18 @@ bool H265Deserialize::DeserializeSeiDecodedPictureHash(H26xBinaryReader::ptr br,
     }
 }
 
-bool H265Deserialize::DeserializeSeiPicTimingSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, H265VuiSyntax::ptr vui, H265HrdSyntax::ptr hrd, H265SeiPicTimingSyntax::ptr pt)
+bool H265Deserialize::DeserializeSeiPicTimingSyntax(const H26xBinaryReader::ptr& br, const H265SpsSyntax::ptr& sps, const H265VuiSyntax::ptr& vui, const H265HrdSyntax::ptr& hrd, const H265SeiPicTimingSyntax::ptr& pt)
 {
     // See also : ITU-T H.265 (2021) - D.2.3 Picture timing SEI message syntax
     try
     {
-        if (vui->frame_field_info_present_flag)
+        if (vui && vui->frame_field_info_present_flag)
         {
             br->U(4, pt->pic_struct);
             br->U(2, pt->source_scan_type);
             br->U(1, pt->duplicate_flag);
         }
-        uint8_t CpbDpbDelaysPresentFlag = (hrd->nal_hrd_parameters_present_flag || hrd->vcl_hrd_parameters_present_flag) ? 1 : 0;
+        uint8_t CpbDpbDelaysPresentFlag = (hrd && (hrd->nal_hrd_parameters_present_flag || hrd->vcl_hrd_parameters_present_flag)) ? 1 : 0;
         if (CpbDpbDelaysPresentFlag)
         {
             br->U(hrd->au_cpb_removal_delay_length_minus1+1, pt->au_cpb_removal_delay_minus1);
@@ -1845,7 +2272,7 @@ bool H265Deserialize::DeserializeSeiPicTimingSyntax(H26xBinaryReader::ptr br, H2
     }
 }
 
-bool H265Deserialize::DeserializeSeiRecoveryPointSyntax(H26xBinaryReader::ptr br, H265SeiRecoveryPointSyntax::ptr rp)
+bool H265Deserialize::DeserializeSeiRecoveryPointSyntax(const H26xBinaryReader::ptr& br, const H265SeiRecoveryPointSyntax::ptr& rp)
 {
     // See also : ITU-T H.265 (2021) - D.2.8 Recovery point SEI message syntax
     try
@@ -1861,7 +2288,7 @@ bool H265Deserialize::DeserializeSeiRecoveryPointSyntax(H26xBinaryReader::ptr br
     }
 }
 
-bool H265Deserialize::DeserializeSeiActiveParameterSetsSyntax(H26xBinaryReader::ptr br, H265VPSSyntax::ptr vps, H265SeiActiveParameterSetsSyntax::ptr aps)
+bool H265Deserialize::DeserializeSeiActiveParameterSetsSyntax(const H26xBinaryReader::ptr& br, const H265VPSSyntax::ptr& vps, const H265SeiActiveParameterSetsSyntax::ptr& aps)
 {
     // See also : ITU-T H.265 (2021) - D.2.21 Active parameter sets SEI message syntax
     try
@@ -1889,7 +2316,7 @@ bool H265Deserialize::DeserializeSeiActiveParameterSetsSyntax(H26xBinaryReader::
     }
 }
 
-bool H265Deserialize::DeserializeSeiTimeCodeSyntax(H26xBinaryReader::ptr br, H265SeiTimeCodeSyntax::ptr tc)
+bool H265Deserialize::DeserializeSeiTimeCodeSyntax(const H26xBinaryReader::ptr& br, const H265SeiTimeCodeSyntax::ptr& tc)
 {
     // See also : ITU-T H.265 (2021) - D.2.27 Time code SEI message syntax
     try
@@ -1960,7 +2387,7 @@ bool H265Deserialize::DeserializeSeiTimeCodeSyntax(H26xBinaryReader::ptr br, H26
     }
 }
 
-bool H265Deserialize::DeserializeSeiMasteringDisplayColourVolumeSyntax(H26xBinaryReader::ptr br, H265MasteringDisplayColourVolumeSyntax::ptr mpcv)
+bool H265Deserialize::DeserializeSeiMasteringDisplayColourVolumeSyntax(const H26xBinaryReader::ptr& br, const H265MasteringDisplayColourVolumeSyntax::ptr& mpcv)
 {
     // See also : ITU-T H.265 (2021) - D.2.28 Mastering display colour volume SEI message syntax
     try
@@ -1982,7 +2409,7 @@ bool H265Deserialize::DeserializeSeiMasteringDisplayColourVolumeSyntax(H26xBinar
     }
 }
 
-bool H265Deserialize::DeserializeSeiContentLightLevelInformationSyntax(H26xBinaryReader::ptr br, H265ContentLightLevelInformationSyntax::ptr clli)
+bool H265Deserialize::DeserializeSeiContentLightLevelInformationSyntax(const H26xBinaryReader::ptr& br, const H265ContentLightLevelInformationSyntax::ptr& clli)
 {
     // See also : ITU-T H.265 (2021) - D.2.35 Content light level information SEI message syntax
     try
@@ -1997,7 +2424,7 @@ bool H265Deserialize::DeserializeSeiContentLightLevelInformationSyntax(H26xBinar
     }
 }
 
-bool H265Deserialize::DeserializeSeiContentColourVolumeSyntax(H26xBinaryReader::ptr br, H265ContentColourVolumeSyntax::ptr ccv)
+bool H265Deserialize::DeserializeSeiContentColourVolumeSyntax(const H26xBinaryReader::ptr& br, const H265ContentColourVolumeSyntax::ptr& ccv)
 {
     // See also : ITU-T H.265 (2021) - D.2.40 Content colour volume SEI message syntax
     try
@@ -2040,7 +2467,7 @@ bool H265Deserialize::DeserializeSeiContentColourVolumeSyntax(H26xBinaryReader::
     }
 }
 
-bool H265Deserialize::DeserializeHrdSyntax(H26xBinaryReader::ptr br, uint8_t commonInfPresentFlag, uint32_t maxNumSubLayersMinus, H265HrdSyntax::ptr hrd)
+bool H265Deserialize::DeserializeHrdSyntax(const H26xBinaryReader::ptr& br, uint8_t commonInfPresentFlag, uint32_t maxNumSubLayersMinus, const H265HrdSyntax::ptr& hrd)
 {
     // See also : ITU-T H.265 (2021) - E.2.2 HRD parameters syntax
     try
@@ -2140,7 +2567,7 @@ bool H265Deserialize::DeserializeHrdSyntax(H26xBinaryReader::ptr br, uint8_t com
     }
 }
 
-bool H265Deserialize::DeserializeSubLayerHrdSyntax(H26xBinaryReader::ptr br, uint32_t subLayerId, H265HrdSyntax::ptr hrd, H265SubLayerHrdSyntax::ptr slHrd)
+bool H265Deserialize::DeserializeSubLayerHrdSyntax(const H26xBinaryReader::ptr& br, uint32_t subLayerId, const H265HrdSyntax::ptr& hrd, const H265SubLayerHrdSyntax::ptr& slHrd)
 {
     // See also : ITU-T H.265 (2021) - E.2.3 Sub-layer HRD parameters syntax
     try
@@ -2170,7 +2597,7 @@ bool H265Deserialize::DeserializeSubLayerHrdSyntax(H26xBinaryReader::ptr br, uin
     }
 }
 
-bool H265Deserialize::DeserializePTLSyntax(H26xBinaryReader::ptr br, uint8_t profilePresentFlag, uint32_t maxNumSubLayersMinus1, H265PTLSyntax::ptr ptl)
+bool H265Deserialize::DeserializePTLSyntax(const H26xBinaryReader::ptr& br, uint8_t profilePresentFlag, uint32_t maxNumSubLayersMinus1, const H265PTLSyntax::ptr& ptl)
 {
     // See also : ITU-T H.265 (2021) - 7.3.3 Profile, tier and level syntax
     try
@@ -2419,7 +2846,7 @@ bool H265Deserialize::DeserializePTLSyntax(H26xBinaryReader::ptr br, uint8_t pro
     }
 }
 
-bool H265Deserialize::DeserializeScalingListDataSyntax(H26xBinaryReader::ptr br, H265ScalingListDataSyntax::ptr sld)
+bool H265Deserialize::DeserializeScalingListDataSyntax(const H26xBinaryReader::ptr& br, const H265ScalingListDataSyntax::ptr& sld)
 {
     // See also : ITU-T H.265 (2021) - 7.3.4 Scaling list data syntax
     try
@@ -2482,7 +2909,7 @@ bool H265Deserialize::DeserializeScalingListDataSyntax(H26xBinaryReader::ptr br,
  * @param[in] stRpsIdx : short term reference picture set index
  * @sa        ITU-T H.265 (2021) - 7.4.8 Short-term reference picture set semantics
  */
-bool H265Deserialize::DeserializeStRefPicSetSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, uint32_t stRpsIdx, H265StRefPicSetSyntax::ptr stps)
+bool H265Deserialize::DeserializeStRefPicSetSyntax(const H26xBinaryReader::ptr& br, const H265SpsSyntax::ptr& sps, uint32_t stRpsIdx, const H265StRefPicSetSyntax::ptr& stps)
 {
     // See also : ITU-T H.265 (2021) - 7.3.7 Short-term reference picture set syntax
     try
@@ -2573,7 +3000,7 @@ bool H265Deserialize::DeserializeStRefPicSetSyntax(H26xBinaryReader::ptr br, H26
     }
 }
 
-bool H265Deserialize::DeserializeColourMappingTable(H26xBinaryReader::ptr br, H265ColourMappingTable::ptr cmt)
+bool H265Deserialize::DeserializeColourMappingTable(const H26xBinaryReader::ptr& br, const H265ColourMappingTable::ptr& cmt)
 {
     // See also : ITU-T H.265 (2021) - F.7.3.2.3.5 General colour mapping table syntax
     try
@@ -2606,7 +3033,7 @@ bool H265Deserialize::DeserializeColourMappingTable(H26xBinaryReader::ptr br, H2
     }
 }
 
-bool H265Deserialize::DeserializePpsMultilayerSyntax(H26xBinaryReader::ptr br, H265PpsMultilayerSyntax::ptr ppsMultilayer)
+bool H265Deserialize::DeserializePpsMultilayerSyntax(const H26xBinaryReader::ptr& br, const H265PpsMultilayerSyntax::ptr& ppsMultilayer)
 {
     // See also : ITU-T H.265 (2021) - F.7.3.2.3.4 Picture parameter set multilayer extension syntax
     try
@@ -2669,7 +3096,7 @@ bool H265Deserialize::DeserializePpsMultilayerSyntax(H26xBinaryReader::ptr br, H
     }
 }
 
-bool H265Deserialize::DeserializeDeltaDltSyntax(H26xBinaryReader::ptr br, H265Pps3dSyntax::ptr pps3d, H265DeltaDltSyntax::ptr dd)
+bool H265Deserialize::DeserializeDeltaDltSyntax(const H26xBinaryReader::ptr& br, const H265Pps3dSyntax::ptr& pps3d, const H265DeltaDltSyntax::ptr& dd)
 {
     // See also : ITU-T H.265 (2021) - I.7.3.2.3.8 Delta depth look-up table syntax
     try
@@ -2704,7 +3131,7 @@ bool H265Deserialize::DeserializeDeltaDltSyntax(H26xBinaryReader::ptr br, H265Pp
     }
 }
 
-void H265Deserialize::DecodingProcessForPictureOrderCount(H265NalUnitHeaderSyntax::ptr header, H265SpsSyntax::ptr sps, H265SliceHeaderSyntax::ptr slice, H265PictureContext::ptr picture)
+void H265Deserialize::DecodingProcessForPictureOrderCount(const H265NalUnitHeaderSyntax::ptr& header, const H265SpsSyntax::ptr& sps, const H265SliceHeaderSyntax::ptr& slice, const H265PictureContext::ptr& picture)
 {
     int64_t prevPicOrderCntLsb = 0, prevPicOrderCntMsb = 0;
     int16_t TemporalId = header->nuh_temporal_id_plus1 - 1; // (7-1)
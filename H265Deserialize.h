@@ -9,11 +9,16 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "H265Common.h"
 #include "H26xBinaryReader.h"
+#include "H26xNalIterator.h"
+#include "H26xSyntaxArena.h"
+#include "H26xThreadPool.h"
 
 namespace Mmp
 {
@@ -31,49 +36,160 @@ public:
     /**
      * @note for H264 Annex B type, common in network stream
      */
-    bool DeserializeByteStreamNalUnit(H26xBinaryReader::ptr br, H265NalSyntax::ptr nal);
-    bool DeserializeNalSyntax(H26xBinaryReader::ptr br, H265NalSyntax::ptr nal);
-    bool DeserializeNalHeaderSyntax(H26xBinaryReader::ptr br, H265NalUnitHeaderSyntax::ptr nalHeader); 
-    bool DeserializePpsSyntax(H26xBinaryReader::ptr br, H265PpsSyntax::ptr pps);
-    bool DeserializeSpsSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps);
-    bool DeserializeVPSSyntax(H26xBinaryReader::ptr br, H265VPSSyntax::ptr vps);
-    bool DeserializeSeiMessageSyntax(H26xBinaryReader::ptr br, H265VPSSyntax::ptr vps, H265SpsSyntax::ptr sps, H265VuiSyntax::ptr vui, H265HrdSyntax::ptr hrd, H265SeiMessageSyntax::ptr sei);
-    bool DeserializeSliceHeaderSyntax(H26xBinaryReader::ptr br, H265NalUnitHeaderSyntax::ptr nal, H265SliceHeaderSyntax::ptr slice);
+    bool DeserializeByteStreamNalUnit(const H26xBinaryReader::ptr& br, const H265NalSyntax::ptr& nal);
+    /**
+     * @brief     nal unit with a length prefix instead of a start code, e.g. samples in MP4 or Matroska
+     * @param[in] lengthSizeMinusOne from HEVCDecoderConfigurationRecord, the length prefix is lengthSizeMinusOne + 1 bytes
+     * @note      the extent of the nal unit is known up front, there is no start code scanning
+     */
+    bool DeserializeLengthPrefixedNalUnit(const H26xBinaryReader::ptr& br, const H265NalSyntax::ptr& nal, uint8_t lengthSizeMinusOne = 3);
+    bool DeserializeNalSyntax(const H26xBinaryReader::ptr& br, const H265NalSyntax::ptr& nal);
+    bool DeserializeNalHeaderSyntax(const H26xBinaryReader::ptr& br, const H265NalUnitHeaderSyntax::ptr& nalHeader); 
+    bool DeserializePpsSyntax(const H26xBinaryReader::ptr& br, const H265PpsSyntax::ptr& pps);
+    bool DeserializeSpsSyntax(const H26xBinaryReader::ptr& br, const H265SpsSyntax::ptr& sps);
+    bool DeserializeVPSSyntax(const H26xBinaryReader::ptr& br, const H265VPSSyntax::ptr& vps);
+    /**
+     * @brief     every sei_message() of a prefix or suffix SEI nal unit, against the active parameter sets
+     * @param[in] br
+     * @param[in] nal
+     * @param[out] seis
+     */
+    bool DeserializeSeiRbspSyntax(const H26xBinaryReader::ptr& br, const H265NalUnitHeaderSyntax::ptr& nal, std::vector<H265SeiMessageSyntax::ptr>& seis);
+    bool DeserializeSeiMessageSyntax(const H26xBinaryReader::ptr& br, const H265NalUnitHeaderSyntax::ptr& nal, const H265VPSSyntax::ptr& vps, const H265SpsSyntax::ptr& sps, const H265VuiSyntax::ptr& vui, const H265HrdSyntax::ptr& hrd, const H265SeiMessageSyntax::ptr& sei);
+    bool DeserializeSliceHeaderSyntax(const H26xBinaryReader::ptr& br, const H265NalUnitHeaderSyntax::ptr& nal, const H265SliceHeaderSyntax::ptr& slice);
+public: /* push mode */
+    /**
+     * @brief     feed Annex B byte stream chunk by chunk as it arrives, e.g. from RTP or TCP
+     * @param[in] data
+     * @param[in] size
+     * @note      bytes are copied, a nal unit may cross the chunks
+     */
+    void Feed(const uint8_t* data, size_t size);
+    /**
+     * @brief no more data, the last nal unit fed is complete
+     */
+    void Flush();
+    /**
+     * @brief      deserialize the next complete nal unit fed
+     * @param[out] nal
+     * @return     false if there is no complete nal unit yet, feed more data (or Flush) then poll again
+     * @note       a nal unit failed to deserialize is dropped, bytes already scanned are never scanned again
+     */
+    bool Poll(const H265NalSyntax::ptr& nal);
+public: /* parallel mode */
+    /**
+     * @brief      deserialize every nal unit of Annex B byte stream in a buffer, e.g. an access unit or a chunk of stream,
+     *             VPS, SPS and PPS serially then the other nal units (slice headers, SEI) in parallel
+     * @param[in]  data
+     * @param[in]  size
+     * @param[out] nals in stream order, a nal unit failed to deserialize is dropped
+     * @param[in]  threads number of threads, the calling thread included
+     * @return     false if any nal unit failed to deserialize
+     * @note       a nal unit is deserialized against an immutable snapshot of the context taken after the parameter sets
+     *             in front of it; syntax objects of the parallel stage always come from the heap
+     */
+    bool DeserializeByteStreamParallel(const uint8_t* data, size_t size, std::vector<H265NalSyntax::ptr>& nals, size_t threads);
+public: /* allocation */
+    /**
+     * @brief     allocate the syntax objects of the following nal units from the arena, nullptr (default) for the heap
+     * @param[in] arena e.g. one per access unit, reset once the syntax objects of the access unit are released
+     * @note      parameter sets live in the context beyond the access unit, they always come from the heap
+     */
+    void SetSyntaxArena(const H26xSyntaxArena::ptr& arena);
+public: /* subscription */
+    /**
+     * @brief     nal unit types to deserialize, bit (1 << nal_unit_type), all by default
+     * @param[in] mask
+     * @note      for the others only the nal unit header is deserialized, the rest is skipped without allocation;
+     *            VPS, SPS and PPS are always deserialized to keep the context consistent
+     */
+    void SetNalUnitTypeMask(uint64_t mask);
+    /**
+     * @brief     SEI payload types to deserialize, empty for all (default)
+     * @param[in] payloadTypes
+     * @note      the others are skipped by payloadSize without allocation
+     */
+    void SetSeiPayloadTypeMask(const std::vector<uint64_t>& payloadTypes);
+public: /* SEI payload handlers */
+    using SeiPayloadHandler = std::function<void(uint64_t payloadType, const uint8_t* data, size_t size)>;
+    /**
+     * @brief     hand the SEI payloads of a type to the caller, e.g. ITU-T T.35 or unregistered user data
+     * @param[in] payloadType
+     * @param[in] handler called with the RBSP bytes of each payload, valid during the call only; nullptr to remove it
+     * @note      handled payloads are not parsed into H265SeiMessageSyntax, from prefix and suffix SEI alike;
+     *            once a handler is registered, the payload types without handler are skipped by payloadSize
+     *            without allocation, unless set by SetSeiPayloadTypeMask;
+     *            with DeserializeByteStreamParallel handlers are called from the worker threads
+     */
+    void RegisterSeiPayloadHandler(uint64_t payloadType, const SeiPayloadHandler& handler);
+private:
+    bool IsNalUnitTypeSubscribed(uint8_t nal_unit_type);
+    bool IsSeiPayloadTypeSubscribed(uint64_t payloadType);
+private:
+    /**
+     * @brief      look up the parameter set byte identical to current nal unit
+     * @param[in]  parameterSetBytes bytes of the parameter sets parsed, by id
+     * @param[out] psBytes bytes of current nal unit, to be saved once it is parsed when there is no match
+     * @return     id of the match, -1 if there is none
+     */
+    int32_t FindParameterSet(const H26xBinaryReader::ptr& br, const std::unordered_map<int32_t, H265ParameterSetBytes>& parameterSetBytes, H265ParameterSetBytes& psBytes);
 private: /* pps */
-    bool DeserializePps3dSyntax(H26xBinaryReader::ptr br, H265PpsSyntax::ptr pps, H265Pps3dSyntax::ptr pps3d);
-    bool DeserializePpsRangeSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, H265PpsSyntax::ptr pps, H265PpsRangeSyntax::ptr ppsRange);
-    bool DeserializePpsSccSyntax(H26xBinaryReader::ptr br, H265PpsSccSyntax::ptr ppsScc);
+    bool DeserializePps3dSyntax(const H26xBinaryReader::ptr& br, const H265PpsSyntax::ptr& pps, const H265Pps3dSyntax::ptr& pps3d);
+    bool DeserializePpsRangeSyntax(const H26xBinaryReader::ptr& br, const H265SpsSyntax::ptr& sps, const H265PpsSyntax::ptr& pps, const H265PpsRangeSyntax::ptr& ppsRange);
+    bool DeserializePpsSccSyntax(const H26xBinaryReader::ptr& br, const H265PpsSccSyntax::ptr& ppsScc);
 private: /* sps */
-    bool DeserializeSpsRangeSyntax(H26xBinaryReader::ptr br, H265SpsRangeSyntax::ptr spsRange);
-    bool DeserializeSps3DSyntax(H26xBinaryReader::ptr br, H265Sps3DSyntax::ptr sps3d);
-    bool DeserializeSpsSccSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, H265SpsSccSyntax::ptr spsScc);
-    bool DeserializeVuiSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, H265VuiSyntax::ptr vui);
+    bool DeserializeSpsRangeSyntax(const H26xBinaryReader::ptr& br, const H265SpsRangeSyntax::ptr& spsRange);
+    bool DeserializeSps3DSyntax(const H26xBinaryReader::ptr& br, const H265Sps3DSyntax::ptr& sps3d);
+    bool DeserializeSpsSccSyntax(const H26xBinaryReader::ptr& br, const H265SpsSyntax::ptr& sps, const H265SpsSccSyntax::ptr& spsScc);
+    bool DeserializeVuiSyntax(const H26xBinaryReader::ptr& br, const H265SpsSyntax::ptr& sps, const H265VuiSyntax::ptr& vui);
 private: /* slice */
-    bool DeserializeRefPicListsModificationSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, H265PpsSyntax::ptr pps, H265SliceHeaderSyntax::ptr slice, H265RefPicListsModificationSyntax::ptr rplm);
-    bool DeserializePredWeightTableSyntax(H26xBinaryReader::ptr br, H265NalUnitHeaderSyntax::ptr header, H265SpsSyntax::ptr sps, H265SliceHeaderSyntax::ptr slice, H265PredWeightTableSyntax::ptr pwt);
+    bool DeserializeRefPicListsModificationSyntax(const H26xBinaryReader::ptr& br, const H265SpsSyntax::ptr& sps, const H265PpsSyntax::ptr& pps, const H265SliceHeaderSyntax::ptr& slice, const H265RefPicListsModificationSyntax::ptr& rplm);
+    bool DeserializePredWeightTableSyntax(const H26xBinaryReader::ptr& br, const H265NalUnitHeaderSyntax::ptr& header, const H265SpsSyntax::ptr& sps, const H265SliceHeaderSyntax::ptr& slice, const H265PredWeightTableSyntax::ptr& pwt);
 private: /* sei */
-    bool DeserializeSeiDecodedPictureHash(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, H265SeiDecodedPictureHashSyntax::ptr dph);
-    bool DeserializeSeiPicTimingSyntax(H26xBinaryReader::ptr br,  H265SpsSyntax::ptr sps, H265VuiSyntax::ptr vui, H265HrdSyntax::ptr hrd, H265SeiPicTimingSyntax::ptr pt);
-    bool DeserializeSeiRecoveryPointSyntax(H26xBinaryReader::ptr br, H265SeiRecoveryPointSyntax::ptr rp);
-    bool DeserializeSeiActiveParameterSetsSyntax(H26xBinaryReader::ptr br, H265VPSSyntax::ptr vps, H265SeiActiveParameterSetsSyntax::ptr aps);
-    bool DeserializeSeiTimeCodeSyntax(H26xBinaryReader::ptr br, H265SeiTimeCodeSyntax::ptr tc);
-    bool DeserializeSeiMasteringDisplayColourVolumeSyntax(H26xBinaryReader::ptr br, H265MasteringDisplayColourVolumeSyntax::ptr mpcv);
-    bool DeserializeSeiContentLightLevelInformationSyntax(H26xBinaryReader::ptr br, H265ContentLightLevelInformationSyntax::ptr clli);
-    bool DeserializeSeiContentColourVolumeSyntax(H26xBinaryReader::ptr br, H265ContentColourVolumeSyntax::ptr ccv);
+    void DeserializeSeiPayloadTypeAndSize(const H26xBinaryReader::ptr& br, uint64_t& payloadType, uint64_t& payloadSize);
+    bool DeserializeSeiPayloadSyntax(const H26xBinaryReader::ptr& br, const H265NalUnitHeaderSyntax::ptr& nal, const H265VPSSyntax::ptr& vps, const H265SpsSyntax::ptr& sps, const H265VuiSyntax::ptr& vui, const H265HrdSyntax::ptr& hrd, const H265SeiMessageSyntax::ptr& sei);
+    /**
+     * @brief skip a payload not deserialized, after handing it to its handler if any
+     */
+    bool SkipSeiPayload(const H26xBinaryReader::ptr& br, uint64_t payloadType, uint64_t payloadSize);
+    bool DeserializeSeiDecodedPictureHash(const H26xBinaryReader::ptr& br, const H265SpsSyntax::ptr& sps, const H265SeiDecodedPictureHashSyntax::ptr& dph);
+    bool DeserializeSeiPicTimingSyntax(const H26xBinaryReader::ptr& br, const H265SpsSyntax::ptr& sps, const H265VuiSyntax::ptr& vui, const H265HrdSyntax::ptr& hrd, const H265SeiPicTimingSyntax::ptr& pt);
+    bool DeserializeSeiRecoveryPointSyntax(const H26xBinaryReader::ptr& br, const H265SeiRecoveryPointSyntax::ptr& rp);
+    bool DeserializeSeiActiveParameterSetsSyntax(const H26xBinaryReader::ptr& br, const H265VPSSyntax::ptr& vps, const H265SeiActiveParameterSetsSyntax::ptr& aps);
+    bool DeserializeSeiTimeCodeSyntax(const H26xBinaryReader::ptr& br, const H265SeiTimeCodeSyntax::ptr& tc);
+    bool DeserializeSeiMasteringDisplayColourVolumeSyntax(const H26xBinaryReader::ptr& br, const H265MasteringDisplayColourVolumeSyntax::ptr& mpcv);
+    bool DeserializeSeiContentLightLevelInformationSyntax(const H26xBinaryReader::ptr& br, const H265ContentLightLevelInformationSyntax::ptr& clli);
+    bool DeserializeSeiContentColourVolumeSyntax(const H26xBinaryReader::ptr& br, const H265ContentColourVolumeSyntax::ptr& ccv);
 private:
-    void DecodingProcessForPictureOrderCount(H265NalUnitHeaderSyntax::ptr header, H265SpsSyntax::ptr sps, H265SliceHeaderSyntax::ptr slice, H265PictureContext::ptr picture);
+    void DecodingProcessForPictureOrderCount(const H265NalUnitHeaderSyntax::ptr& header, const H265SpsSyntax::ptr& sps, const H265SliceHeaderSyntax::ptr& slice, const H265PictureContext::ptr& picture);
 private:
-    bool DeserializeHrdSyntax(H26xBinaryReader::ptr br, uint8_t commonInfPresentFlag, uint32_t maxNumSubLayersMinus, H265HrdSyntax::ptr hrd);
-    bool DeserializeSubLayerHrdSyntax(H26xBinaryReader::ptr br, uint32_t subLayerId, H265HrdSyntax::ptr hrd, H265SubLayerHrdSyntax::ptr slHrd);
-    bool DeserializePTLSyntax(H26xBinaryReader::ptr br, uint8_t profilePresentFlag, uint32_t maxNumSubLayersMinus1, H265PTLSyntax::ptr ptl);
-    bool DeserializeScalingListDataSyntax(H26xBinaryReader::ptr br, H265ScalingListDataSyntax::ptr sld);
-    bool DeserializeStRefPicSetSyntax(H26xBinaryReader::ptr br, H265SpsSyntax::ptr sps, uint32_t stRpsIdx, H265StRefPicSetSyntax::ptr stps);
-    bool DeserializeColourMappingTable(H26xBinaryReader::ptr br, H265ColourMappingTable::ptr cmt);
-    bool DeserializePpsMultilayerSyntax(H26xBinaryReader::ptr br, H265PpsMultilayerSyntax::ptr ppsMultilayer);
-    bool DeserializeDeltaDltSyntax(H26xBinaryReader::ptr br, H265Pps3dSyntax::ptr pps3d, H265DeltaDltSyntax::ptr dd);
+    bool DeserializeHrdSyntax(const H26xBinaryReader::ptr& br, uint8_t commonInfPresentFlag, uint32_t maxNumSubLayersMinus, const H265HrdSyntax::ptr& hrd);
+    bool DeserializeSubLayerHrdSyntax(const H26xBinaryReader::ptr& br, uint32_t subLayerId, const H265HrdSyntax::ptr& hrd, const H265SubLayerHrdSyntax::ptr& slHrd);
+    bool DeserializePTLSyntax(const H26xBinaryReader::ptr& br, uint8_t profilePresentFlag, uint32_t maxNumSubLayersMinus1, const H265PTLSyntax::ptr& ptl);
+    bool DeserializeScalingListDataSyntax(const H26xBinaryReader::ptr& br, const H265ScalingListDataSyntax::ptr& sld);
+    bool DeserializeStRefPicSetSyntax(const H26xBinaryReader::ptr& br, const H265SpsSyntax::ptr& sps, uint32_t stRpsIdx, const H265StRefPicSetSyntax::ptr& stps);
+    bool DeserializeColourMappingTable(const H26xBinaryReader::ptr& br, const H265ColourMappingTable::ptr& cmt);
+    bool DeserializePpsMultilayerSyntax(const H26xBinaryReader::ptr& br, const H265PpsMultilayerSyntax::ptr& ppsMultilayer);
+    bool DeserializeDeltaDltSyntax(const H26xBinaryReader::ptr& br, const H265Pps3dSyntax::ptr& pps3d, const H265DeltaDltSyntax::ptr& dd);
+private: /* parallel mode */
+    /**
+     * @brief the SPS a slice segment refers to, only its first syntax elements are read
+     */
+    H265SpsSyntax::ptr FindSliceSps(const uint8_t* data, size_t size);
 private:
     H265ContextSyntax::ptr _contex;
+    H26xNalIterator::ptr _pushIterator;
     H265PictureContext::ptr _prevTid0Pic;
+private: /* parallel mode */
+    H26xThreadPool::ptr _threadPool;
+    std::vector<std::shared_ptr<H265Deserialize>> _workers;
+    std::vector<H265ContextSyntax::ptr> _workerSnapshots;    // snapshot last copied into each worker
+private: /* allocation */
+    H26xSyntaxArena::ptr _arena;
+private: /* subscription */
+    uint64_t _nalUnitTypeMask;
+    std::vector<bool> _seiPayloadTypeMask;
+    std::unordered_map<uint64_t, SeiPayloadHandler> _seiPayloadHandlers;
 };
 
 } // namespace Codec
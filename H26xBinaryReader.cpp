@@ -1,13 +1,19 @@
 #include "H26xBinaryReader.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <exception>
 #include <stdexcept>
 #include <string>
 
 #include "H26xUltis.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace Mmp
 {
 namespace Codec
@@ -42,18 +48,111 @@ namespace Codec
 //  descriptor is specified in subclause 9.1.
 //
 
-static uint8_t kLeftAndLookUp[8] = {0xFF, 0x7F, 0x3F, 0x1F, 0x0F, 0x07, 0x03, 0x01};
-static uint8_t kRightAndLookUp[8] = {0x80, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC, 0xFE, 0xFF};
+constexpr size_t kWindowChunkSize = 64 * 1024;
+
+// Hint : buffer mode is told apart by a non null _data, an empty buffer is given in place of a null pointer
+static const uint8_t kEmptyBuffer[1] = {0};
+
+static inline uint32_t PopCount64(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_popcountll(value);
+#else
+    uint32_t count = 0;
+    for (; value; count++)
+    {
+        value &= value - 1;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @note value should not be zero
+ */
+static inline uint32_t CountLeadingZeros64(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_clzll(value);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index = 0;
+    _BitScanReverse64(&index, value);
+    return 63 - (uint32_t)index;
+#else
+    uint32_t count = 0;
+    for (uint64_t mask = 1ull << 63; !(value & mask); mask >>= 1)
+    {
+        count++;
+    }
+    return count;
+#endif
+}
+
+static inline bool HasZeroByte(uint64_t value)
+{
+    return ((value - 0x0101010101010101ull) & ~value & 0x8080808080808080ull) != 0;
+}
 
+static inline uint64_t LoadBigEndian64(const uint8_t* data)
+{
+    return ((uint64_t)data[0] << 56) | ((uint64_t)data[1] << 48) | ((uint64_t)data[2] << 40) | ((uint64_t)data[3] << 32) |
+           ((uint64_t)data[4] << 24) | ((uint64_t)data[5] << 16) | ((uint64_t)data[6] << 8)  | ((uint64_t)data[7]);
+}
 
 H26xBinaryReader::H26xBinaryReader(AbstractH26xByteReader::ptr reader)
 {
-    _rbspEndByte = 0;
-    _curBitPos = 8;
-    _curValue = 0;
-    _reader = reader;
+    _cache = 0;
+    _epMask = 0;
+    _cacheBits = 0;
+    _zeroCount = 0;
+    _rbspStopBit = 0;
+    _rbspStopBitValid = false;
     _inNalUnit = false;
+    _eof = false;
+    _reader = reader;
+    _data = _reader->Data();
+    _size = _data ? _reader->Size() : 0;
+    _pos = _reader->Tell();
+    _windowBase = _pos;
+    _rbspMode = false;
+    _stickyErrorMode = false;
+    _error = false;
+    _inRbsp = false;
+    _nalBegin = 0;
+    _nalUnitSize = 0;
+    _nalUnitSizeValid = false;
+    _nalEnd = 0;
+    _nalEndValid = false;
+    _rawData = nullptr;
+    _rawSize = 0;
+}
+
+H26xBinaryReader::H26xBinaryReader(const uint8_t* data, size_t size)
+{
+    _cache = 0;
+    _epMask = 0;
+    _cacheBits = 0;
     _zeroCount = 0;
+    _rbspStopBit = 0;
+    _rbspStopBitValid = false;
+    _inNalUnit = false;
+    _eof = false;
+    _reader = nullptr;
+    _data = data ? data : kEmptyBuffer;
+    _size = data ? size : 0;
+    _pos = 0;
+    _windowBase = 0;
+    _rbspMode = false;
+    _stickyErrorMode = false;
+    _error = false;
+    _inRbsp = false;
+    _nalBegin = 0;
+    _nalUnitSize = 0;
+    _nalUnitSizeValid = false;
+    _nalEnd = 0;
+    _nalEndValid = false;
+    _rawData = nullptr;
+    _rawSize = 0;
 }
 
 H26xBinaryReader::~H26xBinaryReader()
@@ -64,15 +163,34 @@ H26xBinaryReader::~H26xBinaryReader()
 void H26xBinaryReader::UE(uint32_t& value)
 {
     // See also : ISO 14496/10(2020) - 9.1 Parsing process for Exp-Golomb codes
-    int32_t leadingZeroBits = -1;
-    uint64_t tmp = 0;
-    for (uint8_t b = 0; b == 0; leadingZeroBits++)
+    if (_cacheBits < 32)
     {
-        U(1, b);
-        assert(b == 0 || b == 1);
+        Refill();
     }
-    U(leadingZeroBits, tmp);
-    value = (uint32_t)((1 << leadingZeroBits) - 1 + tmp);
+    // Hint : fast path, the whole code (leadingZeroBits + 1 + leadingZeroBits) is in the cache
+    if (_cache)
+    {
+        uint32_t leadingZeroBits = CountLeadingZeros64(_cache);
+        uint32_t codeBits = 2 * leadingZeroBits + 1;
+        if (codeBits <= _cacheBits)
+        {
+            value = (uint32_t)((_cache >> (64 - codeBits)) - 1);
+            SkipBits(codeBits);
+            return;
+        }
+    }
+    uint32_t leadingZeroBits = 0;
+    while (ReadBits(1) == 0)
+    {
+        leadingZeroBits++;
+        if (leadingZeroBits > 32)
+        {
+            RaiseError();
+            value = 0;
+            return;
+        }
+    }
+    value = (uint32_t)((1ull << leadingZeroBits) - 1 + ReadBits(leadingZeroBits));
 }
 
 void H26xBinaryReader::SE(int32_t& value)
@@ -90,135 +208,98 @@ void H26xBinaryReader::SE(int32_t& value)
     }
 }
 
-#define MMP_U_OPERATION(bits, value)            value = 0;\
-                                                bool firstFlag = false;\
-                                                do\
-                                                {\
-                                                    ReadOneByteAuto();\
-                                                    size_t readBits = (size_t)bits <= (8 - (size_t)_curBitPos)? bits : (8 - (size_t)_curBitPos);\
-                                                    bits = (size_t)(bits - readBits);\
-                                                    value <<= readBits;\
-                                                    if (readBits < 8 && !firstFlag)\
-                                                    {\
-                                                        value |= (_curValue & kLeftAndLookUp[_curBitPos]) >> (8 - _curBitPos - readBits);\
-                                                    }\
-                                                    else if (readBits < 8)\
-                                                    {\
-                                                        value |= (_curValue & kRightAndLookUp[readBits - 1]) >> (8 - _curBitPos - readBits);\
-                                                    }\
-                                                    else\
-                                                    {\
-                                                        value |= _curValue;\
-                                                    }\
-                                                    _curBitPos = _curBitPos + readBits;\
-                                                    firstFlag = true;\
-                                                } while (bits != 0);
-
-#define MMP_U_PRED_OPERATION(bits, value)       uint8_t curBitPos = _curBitPos;\
-                                                size_t curPosByte = curBitPos == 8 ? _reader->Tell() : _reader->Tell() - 1;\
-                                                MMP_U_OPERATION(bits, value);\
-                                                _reader->Seek(curPosByte);\
-                                                if (curBitPos != 8)\
-                                                {\
-                                                    ReadOneByteAuto(true);\
-                                                }\
-                                                _curBitPos = curBitPos;
-
-#define MMP_I_OPERATION(bits, value)            MMP_U_OPERATION(bits, value)
-
-#define MMP_I_PRED_OPERATION(bits, value)       MMP_U_PRED_OPERATION(bits, value)
-
 void H26xBinaryReader::U(size_t bits, uint64_t& value)
 {
     if (bits > 64)
     {
-        throw std::out_of_range(std::string());
+        RaiseError();
+        value = 0;
+        return;
     }
-    MMP_U_OPERATION(bits, value);
-}
-
-void H26xBinaryReader::U(size_t bits, uint32_t& value, bool probe)
-{
     if (bits > 32)
     {
-        throw std::out_of_range(std::string());
+        value = ReadBits(bits - 32) << 32;
+        value |= ReadBits(32);
     }
-    if (!probe)
+    else
     {
-        MMP_U_OPERATION(bits, value);
+        value = ReadBits(bits);
     }
-    else
+}
+
+void H26xBinaryReader::U(size_t bits, uint32_t& value, bool probe)
+{
+    if (bits > 32)
     {
-        MMP_U_PRED_OPERATION(bits, value);
+        RaiseError();
+        value = 0;
+        return;
     }
+    value = (uint32_t)(probe ? ShowBits(bits) : ReadBits(bits));
 }
 
 void H26xBinaryReader::U(size_t bits, uint16_t& value)
 {
     if (bits > 16)
     {
-        throw std::out_of_range(std::string());
+        RaiseError();
+        value = 0;
+        return;
     }
-    MMP_U_OPERATION(bits, value);
+    value = (uint16_t)ReadBits(bits);
 }
 
 void H26xBinaryReader::U(size_t bits, uint8_t& value, bool probe)
 {
     if (bits > 8)
     {
-        throw std::out_of_range(std::string());
-    }
-    if (!probe)
-    {
-        MMP_U_OPERATION(bits, value);
-    }
-    else
-    {
-        MMP_U_PRED_OPERATION(bits, value);
+        RaiseError();
+        value = 0;
+        return;
     }
+    value = (uint8_t)(probe ? ShowBits(bits) : ReadBits(bits));
 }
 
 void H26xBinaryReader::I(size_t bits, int64_t& value)
 {
-    if (bits > 64)
-    {
-        throw std::out_of_range(std::string());
-    }
-    MMP_I_OPERATION(bits, value);
+    uint64_t _value = 0;
+    U(bits, _value);
+    value = (int64_t)_value;
 }
 
 void H26xBinaryReader::I(size_t bits, int32_t& value)
 {
     if (bits > 32)
     {
-        throw std::out_of_range(std::string());
+        RaiseError();
+        value = 0;
+        return;
     }
-    MMP_I_OPERATION(bits, value);
+    value = (int32_t)ReadBits(bits);
 }
 
 void H26xBinaryReader::I(size_t bits, int16_t& value)
 {
     if (bits > 16)
     {
-        throw std::out_of_range(std::string());
+        RaiseError();
+        value = 0;
+        return;
     }
-    MMP_I_OPERATION(bits, value);
+    value = (int16_t)ReadBits(bits);
 }
 
 void H26xBinaryReader::I(size_t bits, int8_t& value)
 {
     if (bits > 8)
     {
-        throw std::out_of_range(std::string());
+        RaiseError();
+        value = 0;
+        return;
     }
-    MMP_I_OPERATION(bits, value);
+    value = (int8_t)ReadBits(bits);
 }
 
-#undef MMP_I_PRED_OPERATION
-#undef MMP_I_OPERATION
-#undef MMP_U_PRED_OPERATION
-#undef MMP_U_OPERATION
-
 void H26xBinaryReader::B8(uint8_t& value)
 {
     U(8, value);
@@ -226,50 +307,305 @@ void H26xBinaryReader::B8(uint8_t& value)
 
 void H26xBinaryReader::Skip(size_t bits)
 {
-    if (bits + _curBitPos < 8) // 不需要跳转至下一个字节
+    if (bits < _cacheBits)
     {
-        _curBitPos = uint8_t(bits + _curBitPos);
+        SkipBits(bits);
         return;
     }
-    else // 需要跳转的 bits 先用消费当前 byte 剩余的 bits
+    // Hint : drop the cache, then jump over whole bytes without reading them bit by bit
+    bits -= _cacheBits;
+    _cache = 0;
+    _epMask = 0;
+    _cacheBits = 0;
+    if (CopyRbspBytes(bits / 8, nullptr))
     {
-        bits = bits - (8 - _curBitPos);
-        _curBitPos = 8;
+        SkipBits(bits % 8);
     }
-    size_t skipByte = bits / 8; // 计算需要跳转的字节数
-    if (skipByte)
+}
+
+void H26xBinaryReader::Peek(size_t bits, uint32_t& value)
+{
+    if (bits > 32)
+    {
+        RaiseError();
+        value = 0;
+        return;
+    }
+    if (_cacheBits < bits)
     {
-        _reader->Seek(_reader->Tell() + skipByte);
+        Refill();
+        if (_cacheBits < bits)
+        {
+            // Hint : unlike ShowBits, keep the cache, peek never consumes
+            RaiseError();
+            value = 0;
+            return;
+        }
     }
-    ReadOneByteAuto(true);
-    _curBitPos = bits % 8;
+    value = bits ? (uint32_t)(_cache >> (64 - bits)) : 0;
+}
+
+void H26xBinaryReader::Checkpoint()
+{
+    ReaderState state;
+    state.cache = _cache;
+    state.epMask = _epMask;
+    state.cacheBits = _cacheBits;
+    state.zeroCount = _zeroCount;
+    state.rbspStopBit = _rbspStopBit;
+    state.rbspStopBitValid = _rbspStopBitValid;
+    state.nalEnd = _nalEnd;
+    state.nalEndValid = _nalEndValid;
+    state.inNalUnit = _inNalUnit;
+    state.inRbsp = _inRbsp;
+    state.data = _data;
+    state.size = _size;
+    state.pos = _pos;
+    state.keepPos = KeepPos();
+    state.error = _error;
+    _checkpoints.push_back(state);
+}
+
+void H26xBinaryReader::Rollback()
+{
+    assert(!_checkpoints.empty());
+    if (_checkpoints.empty())
+    {
+        return;
+    }
+    const ReaderState& state = _checkpoints.back();
+    _cache = state.cache;
+    _epMask = state.epMask;
+    _cacheBits = state.cacheBits;
+    _zeroCount = state.zeroCount;
+    _rbspStopBit = state.rbspStopBit;
+    _rbspStopBitValid = state.rbspStopBitValid;
+    _nalEnd = state.nalEnd;
+    _nalEndValid = state.nalEndValid;
+    _inNalUnit = state.inNalUnit;
+    _inRbsp = state.inRbsp;
+    _data = state.data;
+    _size = state.size;
+    _pos = state.pos;
+    _error = state.error;
+    _checkpoints.pop_back();
+}
+
+void H26xBinaryReader::Release()
+{
+    assert(!_checkpoints.empty());
+    if (!_checkpoints.empty())
+    {
+        _checkpoints.pop_back();
+    }
+}
+
+void H26xBinaryReader::SetStickyErrorMode(bool enable)
+{
+    _stickyErrorMode = enable;
+}
+
+bool H26xBinaryReader::HasError()
+{
+    return _error;
+}
+
+void H26xBinaryReader::ClearError()
+{
+    _error = false;
 }
 
 void H26xBinaryReader::MoveNextByte()
 {
-    _curBitPos = 8;
-    ReadOneByteAuto();
+    // Hint : drop the rest bits of current byte
+    SkipBits(_cacheBits % 8);
 }
 
 bool H26xBinaryReader::Eof()
 {
-    return _reader->Eof();
+    size_t bytes = 1;
+    return _cacheBits == 0 && RawBytes(_pos, bytes) == nullptr;
+}
+
+bool H26xBinaryReader::NextStartCode()
+{
+    if (_inRbsp)
+    {
+        Resync();
+    }
+    size_t pos = (CurBits() + 7) / 8;
+    Reposition(pos);
+    bool found = ScanStartCode(pos, pos, true);
+    Seek(pos);
+    return found;
+}
+
+void H26xBinaryReader::SetNalUnitSize(size_t bytes)
+{
+    _nalUnitSize = bytes;
+    _nalUnitSizeValid = true;
 }
 
 void H26xBinaryReader::BeginNalUnit()
 {
+    _nalEndValid = _nalUnitSizeValid;
+    if (_nalUnitSizeValid)
+    {
+        _nalEnd = (CurBits() + 7) / 8 + _nalUnitSize;
+        _nalUnitSizeValid = false;
+    }
     _inNalUnit = true;
+    _rbspStopBitValid = false;
+    if (_rbspMode)
+    {
+        EnterRbsp();
+    }
+    else
+    {
+        Resync();
+    }
 }
 
 
 void H26xBinaryReader::EndNalUnit()
 {
     _inNalUnit = false;
+    Resync();
+}
+
+void H26xBinaryReader::SetRbspMode(bool enable)
+{
+    _rbspMode = enable;
+}
+
+const std::vector<size_t>& H26xBinaryReader::GetEmulationPreventionBytePositions()
+{
+    return _epBytePositions;
+}
+
+bool H26xBinaryReader::PeekNalUnitBytes(const uint8_t*& data, size_t& size)
+{
+    data = nullptr;
+    size = 0;
+    if (!_inNalUnit || SourceBits() % 8)
+    {
+        return false;
+    }
+    if (_inRbsp)
+    {
+        size_t pos = SourceBits() / 8;
+        data = _data + pos;
+        size = _size > pos ? _size - pos : 0;
+        return true;
+    }
+    size_t pos = CurBits() / 8;
+    size_t end = pos;
+    if (_nalEndValid)
+    {
+        end = _nalEnd;
+    }
+    else
+    {
+        ScanStartCode(pos, end, false);
+    }
+    size_t bytes = end > pos ? end - pos : 0;
+    data = bytes ? RawBytes(pos, bytes) : nullptr;
+    if (data)
+    {
+        size = std::min(bytes, end - pos);
+    }
+    // Hint : trailing_zero_8bits (and zero_byte of the next start code) are not part of the nal unit
+    while (size && data[size - 1] == 0)
+    {
+        size--;
+    }
+    return true;
+}
+
+bool H26xBinaryReader::PeekRbspBytes(size_t bytes, const uint8_t*& data)
+{
+    const uint8_t* nalData = nullptr;
+    size_t nalSize = 0;
+    data = nullptr;
+    if (!PeekNalUnitBytes(nalData, nalSize))
+    {
+        return false;
+    }
+    if (_inRbsp)
+    {
+        data = nalData;
+        return nalSize >= bytes;
+    }
+    // Hint : raw bytes are RBSP bytes as long as no emulation prevention byte (0x000003) is among them,
+    //        a 0x03 in the first two bytes may follow zero bytes already read, take it as one
+    bool escaped = false;
+    const uint8_t* end = nalData + std::min(nalSize, bytes);
+    for (const uint8_t* cur = nalData; cur < end; cur++)
+    {
+        cur = (const uint8_t*)memchr(cur, 0x03, end - cur);
+        if (!cur)
+        {
+            break;
+        }
+        if (cur - nalData < 2 || (cur[-1] == 0x00 && cur[-2] == 0x00))
+        {
+            escaped = true;
+            break;
+        }
+    }
+    if (!escaped)
+    {
+        data = nalData;
+        return nalSize >= bytes;
+    }
+    if (_peekBuf.size() < bytes)
+    {
+        _peekBuf.resize(bytes);
+    }
+    bool res = false;
+    Checkpoint();
+    try
+    {
+        res = ReadBytesRbsp(bytes, _peekBuf.data());
+    }
+    catch (const std::out_of_range& /* eof */)
+    {
+        res = false;
+    }
+    Rollback();
+    data = _peekBuf.data();
+    return res;
 }
 
 size_t H26xBinaryReader::CurBits()
 {
-    return _reader->Tell() * 8 + (_curBitPos % 8);
+    // Hint : position in the raw byte stream (emulation prevention bytes included)
+    if (_cacheBits == 0 && _inNalUnit && !_inRbsp)
+    {
+        // Hint : the next byte may follow an emulation prevention byte, fetch it to step over
+        Refill();
+    }
+    size_t curBits = SourceBits();
+    if (_inRbsp)
+    {
+        // Hint : the k-th removed byte is in front of RBSP byte (_epBytePositions[k] - k)
+        size_t byte = curBits / 8;
+        size_t low = 0, high = _epBytePositions.size();
+        while (low < high)
+        {
+            size_t mid = (low + high) / 2;
+            if (_epBytePositions[mid] - mid <= byte)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+        curBits = (_nalBegin + byte + low) * 8 + curBits % 8;
+    }
+    return curBits;
 }
 
 bool H26xBinaryReader::more_rbsp_data()
@@ -284,85 +620,59 @@ bool H26xBinaryReader::more_rbsp_data()
     //   more_rbsp_data( ) is equal to TRUE.
     // - Otherwise, the return value of more_rbsp_data( ) is equal to FALSE.
     //
-    // Hint : 寻找下一个 RBSP 起点 NAL START CODE (0x000003),
+    // Hint : 寻找下一个 RBSP 起点 NAL START CODE (0x000001),
     //        根据 ISO 描述, 在 rbsp_trailing_bits() 后可能存在几个字节的 zero, 此部分不算做 RBSP 范畴内
-    //        
-    if (_rbspEndByte > _reader->Tell()) // cache hint
+    //        rbsp_stop_one_bit 即为最后一个非零字节的最低位 1, 每个 NAL 只需定位一次
+    //
+    if (_inRbsp)
     {
-        return true;
+        return SourceBits() < _rbspStopBit;
     }
-    else if (_reader->Tell() == _rbspEndByte) // reach end of rbsp
+    size_t curBits = CurBits();
+    if (!_rbspStopBitValid)
     {
-        return false;
-    }
-    else // update _rbspEndByte and try once again
-    {
-        bool inNalUnit = _inNalUnit;
-        _inNalUnit = false;
-        uint8_t curBitPos = _curBitPos;
-        size_t curPosByte = curBitPos == 8 ? _reader->Tell() : _reader->Tell() - 1;
-        // 1 - 寻找下一个 RBSP 起点 NAL START CODE (0x000003)
+        // Hint : bytes of the nal unit stay in the look-ahead window, no seek back is needed
+        size_t pos = curBits / 8;
+        size_t end = pos;
+        size_t lastNonZeroPos = 0;
+        uint8_t lastNonZeroByte = 0;
+        if (_nalEndValid)
+        {
+            // Hint : the end of nal unit is told by SetNalUnitSize, only trailing zero bytes are walked over
+            end = _nalEnd;
+        }
+        else
+        {
+            ScanStartCode(pos, end, false);
+        }
+        size_t bytes = end > pos ? end - pos : 0;
+        const uint8_t* data = bytes ? RawBytes(pos, bytes) : nullptr;
+        if (data)
         {
-            try 
+            for (size_t i = std::min(bytes, end - pos); i > 0; i--)
             {
-                uint32_t next_24_bits = 0;
-                U(24, next_24_bits, true);
-                while (next_24_bits != 0x000001)
+                if (data[i - 1])
                 {
-                    if ((next_24_bits & 0xFFFF) == 0)
-                    {
-                        Skip(8);
-                    }
-                    else if ((next_24_bits & 0xFF) == 0)
-                    {
-                        Skip(16);
-                    }
-                    else
-                    {
-                        Skip(32);
-                    }
-                    _rbspEndByte = _reader->Tell();
-                    U(24, next_24_bits, true);
+                    lastNonZeroPos = pos + i - 1;
+                    lastNonZeroByte = data[i - 1];
+                    break;
                 }
             }
-            catch (...)
-            {
-                // Hint : 剩余长度不足 3 时可以进入此异常
-                _rbspEndByte = _reader->Tell();
-            }
         }
-        // 2 - 移除 rbsp_trailing_bits() 后的几个 zero byte (,如果存在的话)
+        _rbspStopBit = 0;
+        if (lastNonZeroByte)
         {
-            try
-            {
-                uint8_t zeroByte = 0;
-                do
-                {
-                    U(8, zeroByte, true);
-                    if (zeroByte == 0)
-                    {
-                        _reader->Seek(_reader->Tell() - 1);
-                        _rbspEndByte = _reader->Tell();
-                    }
-                } while (zeroByte == 0);   
-            }
-            catch (...)
+            uint8_t bitInByte = 7;
+            while (!(lastNonZeroByte & 0x01))
             {
-                // Hint : 无可读数据进入此异常
-                // nothing to do
+                lastNonZeroByte >>= 1;
+                bitInByte--;
             }
+            _rbspStopBit = lastNonZeroPos * 8 + bitInByte;
         }
-        _reader->Seek(curPosByte);
-        if (curBitPos != 8)
-        {
-            ReadOneByteAuto(true);
-        }
-        _curBitPos = curBitPos;
-        _inNalUnit = inNalUnit;
-        return more_rbsp_data();
+        _rbspStopBitValid = true;
     }
-
-    return true;
+    return curBits < _rbspStopBit;
 }
 
 void H26xBinaryReader::rbsp_trailing_bits()
@@ -372,7 +682,7 @@ void H26xBinaryReader::rbsp_trailing_bits()
     uint8_t rbsp_alignment_zero_bit;
     U(1, rbsp_stop_one_bit);
     assert(rbsp_stop_one_bit == 1);
-    while (!(_curBitPos == 0 || _curBitPos == 8))
+    while (_cacheBits % 8 != 0)
     {
         U(1, rbsp_alignment_zero_bit);
         // assert(rbsp_alignment_zero_bit == 0);
@@ -386,7 +696,7 @@ bool H26xBinaryReader::more_data_in_byte_stream()
     // specified as follows:
     // - If more data follow in the byte stream, the return value of more_data_in_byte_stream( ) is equal to TRUE.
     // - Otherwise, the return value of more_data_in_byte_stream( ) is equal to FALSE.
-    return !_reader->Eof();
+    return !Eof();
 }
 
 void H26xBinaryReader::byte_alignment()
@@ -403,19 +713,202 @@ bool H26xBinaryReader::End()
 
 bool H26xBinaryReader::ReadBytes(size_t byte, uint8_t* value)
 {
-    size_t readByte = _reader->Read(value, byte);
-    if (readByte != byte)
+    return ReadBytesRbsp(byte, value);
+}
+
+bool H26xBinaryReader::ReadBytesRbsp(size_t byte, uint8_t* value)
+{
+    size_t i = 0;
+    // Hint : bytes already in the cache, or not byte aligned
+    for (; i < byte && _cacheBits != 0; i++)
+    {
+        value[i] = (uint8_t)ReadBits(8);
+    }
+    if (i < byte && !CopyRbspBytes(byte - i, value + i))
+    {
+        return false;
+    }
+    return !_error;
+}
+
+bool H26xBinaryReader::Seek(size_t offset)
+{
+    if (_data)
+    {
+        _pos = offset < _size ? offset : _size;
+        return _pos == offset;
+    }
+    _pos = offset;
+    if (offset < _windowBase)
+    {
+        // Hint : the bytes are dropped from the look-ahead window, read them again
+        _window.clear();
+        _windowBase = offset;
+        _eof = false;
+        return _reader->Seek(offset);
+    }
+    // Hint : inside or after the look-ahead window, bytes are read when needed
+    return true;
+}
+
+size_t H26xBinaryReader::Tell()
+{
+    return _pos;
+}
+
+const uint8_t* H26xBinaryReader::RawBytes(size_t offset, size_t& bytes)
+{
+    if (_data)
+    {
+        if (offset >= _size)
+        {
+            return nullptr;
+        }
+        bytes = _size - offset;
+        return _data + offset;
+    }
+    assert(offset >= _windowBase);
+    while (_windowBase + _window.size() < offset + bytes && FillWindow(offset))
+    {
+    }
+    size_t windowEnd = _windowBase + _window.size();
+    if (offset >= windowEnd)
+    {
+        return nullptr;
+    }
+    bytes = windowEnd - offset;
+    return _window.data() + (offset - _windowBase);
+}
+
+bool H26xBinaryReader::FillWindow(size_t keepPos)
+{
+    if (_eof)
+    {
+        return false;
+    }
+    // Hint : drop the bytes before the read position and every checkpoint,
+    //        only when it is worth a memmove
+    keepPos = std::min(keepPos, KeepPos());
+    if (keepPos > _windowBase)
+    {
+        size_t dropBytes = std::min(keepPos - _windowBase, _window.size());
+        if (dropBytes >= kWindowChunkSize || (dropBytes && dropBytes == _window.size()))
+        {
+            _window.erase(_window.begin(), _window.begin() + dropBytes);
+            _windowBase += dropBytes;
+        }
+    }
+    size_t size = _window.size();
+    _window.resize(size + kWindowChunkSize);
+    size_t readBytes = _reader->Read(_window.data() + size, kWindowChunkSize);
+    _window.resize(size + readBytes);
+    if (readBytes == 0)
+    {
+        _eof = true;
+        return false;
+    }
+    return true;
+}
+
+size_t H26xBinaryReader::KeepPos()
+{
+    size_t keepPos = _nalBegin;
+    if (!_inRbsp)
+    {
+        // Hint : the first byte in the cache and the emulation prevention byte in front of it
+        size_t backBytes = (_cacheBits + 7) / 8 + PopCount64(_epMask);
+        keepPos = _pos > backBytes ? _pos - backBytes : 0;
+    }
+    for (const ReaderState& state : _checkpoints)
+    {
+        keepPos = std::min(keepPos, state.keepPos);
+    }
+    return keepPos;
+}
+
+bool H26xBinaryReader::ScanStartCode(size_t offset, size_t& startCode, bool consume)
+{
+    size_t from = offset;
+    while (true)
     {
-        throw std::out_of_range("");
+        size_t bytes = 3;
+        const uint8_t* data = RawBytes(from, bytes);
+        if (!data)
+        {
+            startCode = from;
+            return false;
+        }
+        size_t found = FindStartCode(data, bytes);
+        if (found != bytes)
+        {
+            startCode = from + found;
+            return true;
+        }
+        else if (bytes < 3)
+        {
+            startCode = from + bytes;
+            return false;
+        }
+        // Hint : a start code may cross the end of the window, scan from two bytes before
+        from += bytes - 2;
+        if (consume)
+        {
+            // Hint : the bytes scanned are not needed anymore, let the window drop them
+            _pos = from;
+        }
     }
-    return readByte == byte;
 }
 
-void H26xBinaryReader::ReadOneByteAuto(bool force)
+void H26xBinaryReader::Reposition(size_t offset)
+{
+    _cache = 0;
+    _epMask = 0;
+    _cacheBits = 0;
+    _zeroCount = 0;
+    Seek(offset);
+}
+
+bool H26xBinaryReader::FetchByte(uint8_t& value)
 {
-    if (_curBitPos == 8 || force)
+    size_t bytes = 1;
+    const uint8_t* data = RawBytes(_pos, bytes);
+    if (!data)
     {
-        ReadBytes(1, &_curValue);
+        return false;
+    }
+    value = *data;
+    _pos++;
+    return true;
+}
+
+void H26xBinaryReader::Refill()
+{
+    size_t rawBytes = 8;
+    const uint8_t* data = RawBytes(_pos, rawBytes);
+    if (data && rawBytes >= 8)
+    {
+        // Hint : fast path, take as many whole bytes as the cache can hold at once,
+        //        only when there is no emulation prevention byte to remove
+        uint64_t word = LoadBigEndian64(data);
+        uint32_t bytes = (64 - _cacheBits) / 8;
+        uint64_t tailMask = bytes == 8 ? 0 : (~0ull >> (bytes * 8));
+        if (!_inNalUnit || _inRbsp || (!HasZeroByte(word | tailMask) && (_zeroCount != 2 || (word >> 56) != 0x03)))
+        {
+            _cache |= (word & ~tailMask) >> _cacheBits;
+            _cacheBits += bytes * 8;
+            _pos += bytes;
+            _zeroCount = 0;
+            return;
+        }
+    }
+    while (_cacheBits <= 56)
+    {
+        uint8_t value = 0;
+        bool ep = false;
+        if (!FetchByte(value))
+        {
+            break;
+        }
         //  Hint : 0x0000030x -> 0x00000x
         //  The RBSP data is searched for byte-aligned bits of the following binary patterns:
         //  '00000000 00000000 000000xx' (where xx represents any 2 bit pattern: 00, 01, 10, or 11),
@@ -427,12 +920,16 @@ void H26xBinaryReader::ReadOneByteAuto(bool force)
         //  account when searching the RBSP data for the next occurrence of byte-aligned bits with the binary patterns 
         //  specified above.
         //
-        if (_inNalUnit && _zeroCount == 2 && _curValue == 3) 
+        if (_inNalUnit && !_inRbsp && _zeroCount == 2 && value == 3)
         {
-            ReadBytes(1, &_curValue);
+            if (!FetchByte(value))
+            {
+                break;
+            }
+            ep = true;
             _zeroCount = 0;
         }
-        if (_curValue == 0)
+        if (value == 0)
         {
             _zeroCount = (_zeroCount + 1) % 3;
         }
@@ -440,9 +937,259 @@ void H26xBinaryReader::ReadOneByteAuto(bool force)
         {
             _zeroCount = 0;
         }
-        _curBitPos = 0;
+        _cache |= (uint64_t)value << (56 - _cacheBits);
+        if (ep)
+        {
+            _epMask |= 1ull << (63 - _cacheBits);
+        }
+        _cacheBits += 8;
+    }
+}
+
+bool H26xBinaryReader::CopyRbspBytes(size_t bytes, uint8_t* value)
+{
+    assert(_cacheBits == 0);
+    bool removeEmulationPrevention = _inNalUnit && !_inRbsp;
+    while (bytes)
+    {
+        if (removeEmulationPrevention && _zeroCount != 0)
+        {
+            // Hint : an emulation prevention byte may follow the zero bytes read before, go byte by byte as Refill
+            uint8_t byte = 0;
+            if (!FetchByte(byte))
+            {
+                break;
+            }
+            if (_zeroCount == 2 && byte == 3)
+            {
+                if (!FetchByte(byte))
+                {
+                    break;
+                }
+                _zeroCount = 0;
+            }
+            _zeroCount = byte == 0 ? (_zeroCount + 1) % 3 : 0;
+            if (value)
+            {
+                *value++ = byte;
+            }
+            bytes--;
+            continue;
+        }
+        size_t rawBytes = 1;
+        const uint8_t* data = RawBytes(_pos, rawBytes);
+        if (!data)
+        {
+            break;
+        }
+        size_t copyBytes = std::min(rawBytes, bytes);
+        size_t skipBytes = 0;
+        if (removeEmulationPrevention)
+        {
+            size_t offset = FindEmulationPrevention(data, copyBytes);
+            if (offset != copyBytes)
+            {
+                // Hint : 0x000003 -> 0x0000
+                copyBytes = offset + 2;
+                skipBytes = 1;
+            }
+            else
+            {
+                size_t zeroBytes = 0;
+                while (zeroBytes < copyBytes && data[copyBytes - zeroBytes - 1] == 0)
+                {
+                    zeroBytes++;
+                }
+                _zeroCount = zeroBytes % 3;
+            }
+        }
+        if (value)
+        {
+            memcpy(value, data, copyBytes);
+            value += copyBytes;
+        }
+        _pos += copyBytes + skipBytes;
+        bytes -= copyBytes;
+    }
+    if (bytes)
+    {
+        if (value)
+        {
+            memset(value, 0, bytes);
+        }
+        RaiseError();
+        return false;
+    }
+    return true;
+}
+
+void H26xBinaryReader::Resync()
+{
+    // Hint : bytes in the cache are fetched ahead, the emulation prevention state of them
+    //        may be changed when entering or leaving a nal unit, fetch them again
+    size_t curBits = CurBits();
+    if (_inRbsp)
+    {
+        _data = _rawData;
+        _size = _rawSize;
+        _inRbsp = false;
+    }
+    Reposition(curBits / 8);
+    if (curBits % 8)
+    {
+        SkipBits(curBits % 8);
+    }
+}
+
+void H26xBinaryReader::EnterRbsp()
+{
+    if (_inRbsp)
+    {
+        Resync();
+    }
+    // 1 - locate the whole nal unit in the raw byte stream
+    const uint8_t* nal = nullptr;
+    size_t nalSize = 0;
+    _nalBegin = (CurBits() + 7) / 8;
+    Reposition(_nalBegin);
+    if (_nalEndValid)
+    {
+        nalSize = _nalEnd > _nalBegin ? _nalEnd - _nalBegin : 0;
+    }
+    else
+    {
+        ScanStartCode(_nalBegin, nalSize, false);
+        nalSize -= _nalBegin;
+    }
+    if (nalSize)
+    {
+        size_t bytes = nalSize;
+        nal = RawBytes(_nalBegin, bytes);
+        nalSize = nal ? std::min(bytes, nalSize) : 0;
+    }
+    // Hint : trailing_zero_8bits (and zero_byte of the next start code) are not part of the nal unit
+    while (nalSize && nal[nalSize - 1] == 0)
+    {
+        nalSize--;
+    }
+    // 2 - remove every emulation_prevention_three_byte
+    if (_rbsp.size() < nalSize || _rbsp.empty())
+    {
+        // Hint : never empty, _data is also the flag of contiguous buffer mode
+        _rbsp.resize(nalSize ? nalSize : 1);
+    }
+    _epBytePositions.clear();
+    size_t rbspSize = 0;
+    for (size_t pos = 0; pos < nalSize;)
+    {
+        size_t offset = FindEmulationPrevention(nal + pos, nalSize - pos);
+        size_t copyBytes = offset == nalSize - pos ? offset : offset + 2;
+        memcpy(_rbsp.data() + rbspSize, nal + pos, copyBytes);
+        rbspSize += copyBytes;
+        pos += copyBytes;
+        if (pos < nalSize)
+        {
+            _epBytePositions.push_back(pos);
+            pos++;
+        }
+    }
+    // 3 - rbsp_stop_one_bit is the last bit equal to 1
+    _rbspStopBit = 0;
+    for (size_t pos = rbspSize; pos > 0; pos--)
+    {
+        uint8_t lastByte = _rbsp[pos - 1];
+        if (lastByte)
+        {
+            uint8_t bitInByte = 7;
+            while (!(lastByte & 0x01))
+            {
+                lastByte >>= 1;
+                bitInByte--;
+            }
+            _rbspStopBit = (pos - 1) * 8 + bitInByte;
+            break;
+        }
+    }
+    _rbspStopBitValid = true;
+    // 4 - read from the RBSP buffer until the end of the nal unit
+    _rawData = _data;
+    _rawSize = _size;
+    _inRbsp = true;
+    _data = _rbsp.data();
+    _size = rbspSize;
+    _pos = 0;
+    _cache = 0;
+    _epMask = 0;
+    _cacheBits = 0;
+    _zeroCount = 0;
+}
+
+size_t H26xBinaryReader::SourceBits()
+{
+    // Hint : position in the current source, raw byte stream or RBSP buffer
+    size_t cacheBytes = (_cacheBits + 7) / 8;
+    size_t epBytes = PopCount64(_epMask & 0x7FFFFFFFFFFFFFFFull);
+    return (Tell() - cacheBytes - epBytes) * 8 + (8 - _cacheBits % 8) % 8;
+}
+
+void H26xBinaryReader::RaiseError()
+{
+    if (!_stickyErrorMode)
+    {
+        throw std::out_of_range(std::string());
+    }
+    _error = true;
+}
+
+uint64_t H26xBinaryReader::ShowBits(size_t bits)
+{
+    if (bits == 0)
+    {
+        return 0;
+    }
+    if (_cacheBits < bits)
+    {
+        Refill();
+        if (_cacheBits < bits)
+        {
+            // Hint : no enough data, consume all
+            _cache = 0;
+            _epMask = 0;
+            _cacheBits = 0;
+            RaiseError();
+            return 0;
+        }
+    }
+    return _cache >> (64 - bits);
+}
+
+void H26xBinaryReader::SkipBits(size_t bits)
+{
+    if (bits == 0)
+    {
+        return;
+    }
+    ShowBits(bits);
+    if (_cacheBits < bits)
+    {
+        return;
+    }
+    _cache <<= bits;
+    _epMask <<= bits;
+    _cacheBits -= (uint32_t)bits;
+}
+
+uint64_t H26xBinaryReader::ReadBits(size_t bits)
+{
+    uint64_t value = ShowBits(bits);
+    if (bits && _cacheBits >= bits)
+    {
+        _cache <<= bits;
+        _epMask <<= bits;
+        _cacheBits -= (uint32_t)bits;
     }
+    return value;
 }
 
 } // namespace Codec
-} // namespace Mmp
\ No newline at end of file
+} // namespace Mmp
@@ -21,7 +21,17 @@ class H26xBinaryReader
 public:
     using ptr = std::shared_ptr<H26xBinaryReader>;
 public:
+    /**
+     * @note if the reader provides AbstractH26xByteReader::Data(), parse from it directly
+     */
     explicit H26xBinaryReader(AbstractH26xByteReader::ptr reader);
+    /**
+     * @brief     parse directly from a caller-owned contiguous buffer
+     * @param[in] data
+     * @param[in] size
+     * @note      the buffer must outlive the reader, no copy is made; a null data is an empty buffer
+     */
+    explicit H26xBinaryReader(const uint8_t* data, size_t size);
     virtual ~H26xBinaryReader();
 public:
     void UE(uint32_t& value);
@@ -41,12 +51,83 @@ public:
     void B8(uint8_t& value);
 public:
     void Skip(size_t bits);
+public:
+    /**
+     * @brief     get the next bits without consuming them
+     * @param[in] bits no more than 32
+     */
+    void Peek(size_t bits, uint32_t& value);
+    /**
+     * @brief save current read state, checkpoints can be nested
+     * @note  bytes after the oldest checkpoint are kept in the look-ahead window,
+     *        in RBSP mode do not roll back across the next BeginNalUnit
+     */
+    void Checkpoint();
+    /**
+     * @brief go back to the read state saved by the last Checkpoint and drop it
+     */
+    void Rollback();
+    /**
+     * @brief drop the last Checkpoint, keep current read state
+     */
+    void Release();
+public:
+    /**
+     * @brief     sticky error mode, reading beyond the end of data (or an invalid read) does not throw
+     *            std::out_of_range, the read returns zero and the error flag is set until ClearError()
+     * @param[in] enable
+     * @note      check HasError() once per syntax structure instead of catching exceptions
+     */
+    void SetStickyErrorMode(bool enable);
+    bool HasError();
+    void ClearError();
 public:
     void MoveNextByte();
     bool Eof();
+    /**
+     * @brief  move to the next start code prefix (0x000001) from current byte
+     * @return false if there is no more start code, then the reader reaches the end
+     */
+    bool NextStartCode();
 public:
+    /**
+     * @brief     size of the next nal unit when it is already known, e.g. from a start code scan or a length prefix
+     * @param[in] bytes nal unit size in the raw byte stream, from the first byte of nal unit header
+     * @note      taken by the next BeginNalUnit, then more_rbsp_data() and RBSP mode do not scan for the next start code
+     */
+    void SetNalUnitSize(size_t bytes);
     void BeginNalUnit();
     void EndNalUnit();
+    /**
+     * @brief     RBSP mode, the whole nal unit is unescaped into a RBSP buffer once in BeginNalUnit,
+     *            then read without per byte emulation prevention check
+     * @param[in] enable
+     */
+    void SetRbspMode(bool enable);
+    /**
+     * @brief  offsets of the emulation prevention bytes removed from current nal unit,
+     *         relative to the first byte of the nal unit in the raw byte stream
+     * @note   only available in RBSP mode
+     */
+    const std::vector<size_t>& GetEmulationPreventionBytePositions();
+    /**
+     * @brief      bytes of current nal unit from the read position to its end, without consuming them
+     * @param[out] data valid until the next read
+     * @param[out] size
+     * @return     false if not in a nal unit or the read position is not byte aligned
+     * @note       RBSP bytes in RBSP mode, otherwise raw bytes (emulation prevention bytes included),
+     *             trailing zero bytes are excluded
+     */
+    bool PeekNalUnitBytes(const uint8_t*& data, size_t& size);
+    /**
+     * @brief      the next RBSP bytes of current nal unit, without consuming them
+     * @param[in]  bytes
+     * @param[out] data valid until the next read
+     * @return     false if not in a nal unit, the read position is not byte aligned or there are not enough bytes
+     * @note       no copy in RBSP mode, nor in raw mode when there is no emulation prevention byte among them;
+     *             otherwise they are unescaped into a buffer kept by the reader for the next calls
+     */
+    bool PeekRbspBytes(size_t bytes, const uint8_t*& data);
 public:
     size_t CurBits();
 public:
@@ -58,18 +139,99 @@ public:
 public:
     bool End();
 public:
-    void ReadOneByteAuto(bool force = false);
     bool ReadBytes(size_t byte, uint8_t* value);
+    /**
+     * @brief     read whole RBSP bytes in bulk, emulation prevention bytes are removed block by block
+     * @param[in] byte
+     * @param[out] value
+     * @note      byte aligned reads take the fast path, e.g. SEI payloads and user data
+     */
+    bool ReadBytesRbsp(size_t byte, uint8_t* value);
+private:
+    bool Seek(size_t offset);
+    size_t Tell();
+private:
+    const uint8_t* RawBytes(size_t offset, size_t& bytes);
+    bool FillWindow(size_t keepPos);
+    size_t KeepPos();
+    bool ScanStartCode(size_t offset, size_t& startCode, bool consume);
+    void Reposition(size_t offset);
 private:
-    uint8_t  _curBitPos;
-    uint8_t  _curValue;
+    bool FetchByte(uint8_t& value);
+    void Refill();
+    /**
+     * @brief copy whole RBSP bytes from current source to value, or skip them if value is nullptr
+     * @note  the bit cache should be empty
+     */
+    bool CopyRbspBytes(size_t bytes, uint8_t* value);
+    void Resync();
+    void EnterRbsp();
+    size_t SourceBits();
+    /**
+     * @brief throw std::out_of_range, or set the error flag in sticky error mode
+     */
+    void RaiseError();
+    uint64_t ShowBits(size_t bits);
+    void SkipBits(size_t bits);
+    uint64_t ReadBits(size_t bits);
+private: /* bit cache */
+    uint64_t _cache;      // MSB aligned, the next bit to read is bit 63
+    uint64_t _epMask;     // MSB of each cached byte which follows a removed emulation prevention byte
+    uint32_t _cacheBits;
 private:
     uint32_t _zeroCount;
-    uint64_t _rbspEndByte;
+    uint64_t _rbspStopBit;
+    bool     _rbspStopBitValid;
+private:
+    size_t _nalUnitSize;
+    bool   _nalUnitSizeValid;
+    size_t _nalEnd;
+    bool   _nalEndValid;
 private:
     bool _inNalUnit;
+    bool _eof;
+private:
+    bool _stickyErrorMode;
+    bool _error;
 private:
     AbstractH26xByteReader::ptr _reader;
+private: /* contiguous buffer mode */
+    const uint8_t* _data;
+    size_t _size;
+    size_t _pos;
+private: /* look-ahead window, reader mode */
+    std::vector<uint8_t> _window;
+    size_t _windowBase;
+private:
+    struct ReaderState
+    {
+        uint64_t       cache;
+        uint64_t       epMask;
+        uint32_t       cacheBits;
+        uint32_t       zeroCount;
+        uint64_t       rbspStopBit;
+        bool           rbspStopBitValid;
+        size_t         nalEnd;
+        bool           nalEndValid;
+        bool           inNalUnit;
+        bool           inRbsp;
+        const uint8_t* data;
+        size_t         size;
+        size_t         pos;
+        size_t         keepPos;
+        bool           error;
+    };
+    std::vector<ReaderState> _checkpoints;
+private: /* RBSP mode */
+    bool _rbspMode;
+    bool _inRbsp;
+    size_t _nalBegin;
+    std::vector<uint8_t> _rbsp;
+    std::vector<size_t> _epBytePositions;
+    const uint8_t* _rawData;
+    size_t _rawSize;
+private:
+    std::vector<uint8_t> _peekBuf;    // unescaped bytes of PeekRbspBytes
 };
 
 } // namespace Codec
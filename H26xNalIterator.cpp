@@ -0,0 +1,396 @@
+#include "H26xNalIterator.h"
+
+#include <cstring>
+
+#include "H26xUltis.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+constexpr size_t kNalIteratorChunkSize = 64 * 1024;
+
+H26xNalUnitView::H26xNalUnitView()
+{
+    offset = 0;
+    startCodeLength = 0;
+    data = nullptr;
+    size = 0;
+    nal_unit_type = 0;
+    nal_ref_idc = 0;
+    nuh_layer_id = 0;
+    nuh_temporal_id_plus1 = 0;
+}
+
+H26xNalIterator::H26xNalIterator(const uint8_t* data, size_t size, H26xCodecType codec)
+{
+    _codec = codec;
+    _data = data;
+    _size = size;
+    _pos = 0;
+    _reader = nullptr;
+    _base = 0;
+    _eof = true;
+    _push = false;
+    _scanPos = 0;
+}
+
+H26xNalIterator::H26xNalIterator(AbstractH26xByteReader::ptr reader, H26xCodecType codec)
+{
+    _codec = codec;
+    _pos = 0;
+    _base = 0;
+    _eof = true;
+    _data = reader->Data();
+    if (_data)
+    {
+        _size = reader->Size();
+        _pos = reader->Tell();
+        _reader = nullptr;
+    }
+    else
+    {
+        _size = 0;
+        _reader = reader;
+        _base = reader->Tell();
+        _eof = false;
+    }
+    _push = false;
+    _scanPos = 0;
+}
+
+H26xNalIterator::H26xNalIterator(H26xCodecType codec)
+{
+    _codec = codec;
+    _data = nullptr;
+    _size = 0;
+    _pos = 0;
+    _reader = nullptr;
+    _base = 0;
+    _eof = false;
+    _push = true;
+    _scanPos = 0;
+}
+
+void H26xNalIterator::Feed(const uint8_t* data, size_t size)
+{
+    // Hint : Feed after Flush starts a new stream segment
+    _eof = false;
+    Compact();
+    _buf.insert(_buf.end(), data, data + size);
+    _data = _buf.data();
+    _size = _buf.size();
+}
+
+void H26xNalIterator::Flush()
+{
+    _eof = true;
+}
+
+bool H26xNalIterator::Next(H26xNalUnitView& view)
+{
+    if (_reader || _push)
+    {
+        Compact();
+    }
+    size_t startCode = FindNextStartCode(_pos);
+    if (startCode == _size)
+    {
+        if (!_push || _eof)
+        {
+            _pos = _size;
+        }
+        else if (_size > _pos + 3)
+        {
+            // Hint : in push mode, a start code may cross the chunk, keep the last bytes (zero_byte included)
+            _pos = _size - 3;
+        }
+        return false;
+    }
+    size_t begin = startCode + 3;
+    // Hint : in push mode, continue the scan where the last call stopped
+    size_t end = FindNextStartCode(_scanPos > begin ? _scanPos : begin);
+    if (_push && !_eof && end == _size)
+    {
+        // Hint : the nal unit is not complete yet, keep the byte in front of the start code for zero_byte
+        _scanPos = _size > begin + 2 ? _size - 2 : begin;
+        _pos = startCode > _pos ? startCode - 1 : startCode;
+        return false;
+    }
+    _scanPos = 0;
+    // Hint : trailing_zero_8bits and zero_byte of the next start code are not part of the nal unit,
+    //        keep them for the next iteration
+    while (end > begin && _data[end - 1] == 0)
+    {
+        end--;
+    }
+    view.startCodeLength = (startCode > _pos && _data[startCode - 1] == 0) ? 4 : 3;
+    view.offset = _base + startCode + 3 - view.startCodeLength;
+    view.data = _data + begin;
+    view.size = end - begin;
+    view.nal_unit_type = 0;
+    view.nal_ref_idc = 0;
+    view.nuh_layer_id = 0;
+    view.nuh_temporal_id_plus1 = 0;
+    if (_codec == MMP_H26X_CODEC_H264 && view.size >= 1)
+    {
+        // forbidden_zero_bit f(1), nal_ref_idc u(2), nal_unit_type u(5)
+        view.nal_ref_idc = (view.data[0] >> 5) & 0x03;
+        view.nal_unit_type = view.data[0] & 0x1F;
+    }
+    else if (_codec == MMP_H26X_CODEC_H265 && view.size >= 2)
+    {
+        // forbidden_zero_bit f(1), nal_unit_type u(6), nuh_layer_id u(6), nuh_temporal_id_plus1 u(3)
+        view.nal_unit_type = (view.data[0] >> 1) & 0x3F;
+        view.nuh_layer_id = ((view.data[0] & 0x01) << 5) | (view.data[1] >> 3);
+        view.nuh_temporal_id_plus1 = view.data[1] & 0x07;
+    }
+    _pos = end;
+    return true;
+}
+
+size_t H26xNalIterator::FindNextStartCode(size_t from)
+{
+    size_t scanFrom = from;
+    while (true)
+    {
+        size_t offset = FindStartCode(_data + scanFrom, _size - scanFrom);
+        if (offset != _size - scanFrom)
+        {
+            return scanFrom + offset;
+        }
+        size_t size = _size;
+        if (!Fill())
+        {
+            return _size;
+        }
+        // Hint : a start code may cross the chunk
+        scanFrom = size < from + 2 ? from : size - 2;
+    }
+}
+
+void H26xNalIterator::Compact()
+{
+    // Hint : drop the bytes already iterated only once they are at least half of the buffer,
+    //        so that every byte is moved a bounded number of times
+    if (_pos == 0 || _pos * 2 < _buf.size())
+    {
+        return;
+    }
+    memmove(_buf.data(), _buf.data() + _pos, _buf.size() - _pos);
+    _buf.resize(_buf.size() - _pos);
+    _base += _pos;
+    _scanPos = _scanPos > _pos ? _scanPos - _pos : 0;
+    _pos = 0;
+    _data = _buf.data();
+    _size = _buf.size();
+}
+
+bool H26xNalIterator::Fill()
+{
+    if (!_reader || _eof)
+    {
+        return false;
+    }
+    size_t size = _buf.size();
+    _buf.resize(size + kNalIteratorChunkSize);
+    size_t readBytes = _reader->Read(_buf.data() + size, kNalIteratorChunkSize);
+    _buf.resize(size + readBytes);
+    _data = _buf.data();
+    _size = _buf.size();
+    if (readBytes == 0)
+    {
+        _eof = true;
+        return false;
+    }
+    return true;
+}
+
+namespace
+{
+
+/**
+ * @brief minimal bit reader over the raw bytes of a nal unit, emulation prevention bytes are skipped
+ * @note  only used for the first syntax elements of a slice header, see ClassifyNalUnit
+ */
+class H26xRawBitReader
+{
+public:
+    H26xRawBitReader(const uint8_t* data, size_t size);
+public:
+    bool U1(uint32_t& value);
+    bool UE(uint32_t& value);
+private:
+    const uint8_t* _data;
+    size_t _size;
+    size_t _pos;
+    uint8_t _bit;
+    uint8_t _zeroCount;
+};
+
+H26xRawBitReader::H26xRawBitReader(const uint8_t* data, size_t size)
+{
+    _data = data;
+    _size = size;
+    _pos = 0;
+    _bit = 0;
+    _zeroCount = 0;
+}
+
+bool H26xRawBitReader::U1(uint32_t& value)
+{
+    if (_pos >= _size)
+    {
+        return false;
+    }
+    value = (_data[_pos] >> (7 - _bit)) & 0x01;
+    if (++_bit == 8)
+    {
+        _bit = 0;
+        _zeroCount = _data[_pos] == 0 ? _zeroCount + 1 : 0;
+        _pos++;
+        if (_zeroCount >= 2 && _pos < _size && _data[_pos] == 0x03)
+        {
+            // Hint : emulation_prevention_three_byte
+            _pos++;
+            _zeroCount = 0;
+        }
+    }
+    return true;
+}
+
+bool H26xRawBitReader::UE(uint32_t& value)
+{
+    // See also : ISO 14496/10(2020) - 9.1 Parsing process for Exp-Golomb codes
+    uint32_t bit = 0;
+    uint32_t leadingZeroBits = 0;
+    while (true)
+    {
+        if (!U1(bit))
+        {
+            return false;
+        }
+        if (bit)
+        {
+            break;
+        }
+        if (++leadingZeroBits > 31)
+        {
+            return false;
+        }
+    }
+    uint64_t suffix = 0;
+    for (uint32_t i=0; i<leadingZeroBits; i++)
+    {
+        if (!U1(bit))
+        {
+            return false;
+        }
+        suffix = (suffix << 1) | bit;
+    }
+    value = (uint32_t)(((uint64_t)1 << leadingZeroBits) - 1 + suffix);
+    return true;
+}
+
+} // namespace
+
+H26xSliceClassification::H26xSliceClassification()
+{
+    sliceClass = MMP_H26X_SLICE_CLASS_NONE;
+    nal_unit_type = 0;
+    firstSliceInPicture = false;
+}
+
+bool H26xSliceClassification::IsRandomAccess() const
+{
+    return sliceClass >= MMP_H26X_SLICE_CLASS_IDR;
+}
+
+H26xSliceClassification ClassifyNalUnit(H26xCodecType codec, const uint8_t* data, size_t size)
+{
+    H26xSliceClassification classification;
+    if (codec == MMP_H26X_CODEC_H264 && size >= 1)
+    {
+        // See also : ISO 14496/10(2020) - 7.3.3 Slice header syntax
+        classification.nal_unit_type = data[0] & 0x1F;
+        if (classification.nal_unit_type != H264NaluType::MMP_H264_NALU_TYPE_SLICE && 
+            classification.nal_unit_type != H264NaluType::MMP_H264_NALU_TYPE_DPA &&
+            classification.nal_unit_type != H264NaluType::MMP_H264_NALU_TYPE_IDR
+        )
+        {
+            return classification;
+        }
+        uint32_t first_mb_in_slice = 0;
+        uint32_t slice_type = 0;
+        H26xRawBitReader br(data + 1, size - 1);
+        if (!br.UE(first_mb_in_slice) || !br.UE(slice_type))
+        {
+            return classification;
+        }
+        classification.firstSliceInPicture = first_mb_in_slice == 0;
+        if (classification.nal_unit_type == H264NaluType::MMP_H264_NALU_TYPE_IDR)
+        {
+            classification.sliceClass = MMP_H26X_SLICE_CLASS_IDR;
+        }
+        else if (slice_type % 5 == H264SliceType::MMP_H264_I_SLICE || slice_type % 5 == H264SliceType::MMP_H264_SI_SLICE)
+        {
+            classification.sliceClass = MMP_H26X_SLICE_CLASS_I_SLICE;
+        }
+        else
+        {
+            classification.sliceClass = MMP_H26X_SLICE_CLASS_NON_KEY;
+        }
+    }
+    else if (codec == MMP_H26X_CODEC_H265 && size >= 3)
+    {
+        // See also : ITU-T H.265 (2021) - 7.3.6.1 General slice segment header syntax
+        // Hint : slice_type is behind syntax elements depending on the PPS, only IRAP pictures are told apart
+        classification.nal_unit_type = (data[0] >> 1) & 0x3F;
+        if (classification.nal_unit_type > H265NaluType::MMP_H265_NALU_TYPE_RSV_IRAP_VCL23)
+        {
+            return classification;
+        }
+        classification.firstSliceInPicture = (data[2] >> 7) & 0x01;
+        if (classification.nal_unit_type >= H265NaluType::MMP_H265_NALU_TYPE_BLA_W_LP && classification.nal_unit_type <= H265NaluType::MMP_H265_NALU_TYPE_BLA_N_LP)
+        {
+            classification.sliceClass = MMP_H26X_SLICE_CLASS_BLA;
+        }
+        else if (classification.nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_IDR_W_RADL || classification.nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_IDR_N_LP)
+        {
+            classification.sliceClass = MMP_H26X_SLICE_CLASS_IDR;
+        }
+        else if (classification.nal_unit_type == H265NaluType::MMP_H265_NALU_TYPE_CRA_NUT)
+        {
+            classification.sliceClass = MMP_H26X_SLICE_CLASS_CRA;
+        }
+        else if (classification.nal_unit_type < H265NaluType::MMP_H265_NALU_TYPE_BLA_W_LP)
+        {
+            classification.sliceClass = MMP_H26X_SLICE_CLASS_NON_KEY;
+        }
+    }
+    return classification;
+}
+
+H26xSliceClassification ClassifyByteStream(H26xCodecType codec, const uint8_t* data, size_t size)
+{
+    H26xSliceClassification classification;
+    H26xNalIterator iterator(data, size, codec);
+    H26xNalUnitView view;
+    while (iterator.Next(view))
+    {
+        H26xSliceClassification cur = ClassifyNalUnit(codec, view.data, view.size);
+        if (cur.sliceClass > classification.sliceClass)
+        {
+            classification = cur;
+            if (classification.IsRandomAccess())
+            {
+                break;
+            }
+        }
+    }
+    return classification;
+}
+
+} // namespace Codec
+} // namespace Mmp
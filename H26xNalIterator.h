@@ -0,0 +1,165 @@
+//
+// H26xNalIterator.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+// 
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "AbstractH26xByteReader.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+enum H26xCodecType
+{
+    MMP_H26X_CODEC_H264 = 0,
+    MMP_H26X_CODEC_H265 = 1
+};
+
+/**
+ * @brief nal unit located in the byte stream, only the nal unit header is decoded
+ * @sa    1 - ISO 14496/10(2020) - 7.3.1 NAL unit syntax
+ *        2 - ITU-T H.265 (2021) - 7.3.1.2 NAL unit header syntax
+ */
+class H26xNalUnitView
+{
+public:
+    H26xNalUnitView();
+    ~H26xNalUnitView() = default;
+public:
+    size_t         offset;                 // offset of the start code in the byte stream, zero_byte included
+    uint8_t        startCodeLength;        // 3 or 4 (with zero_byte)
+    const uint8_t* data;                   // nal unit (header included), emulation prevention bytes not removed
+    size_t         size;
+public:
+    uint8_t        nal_unit_type;
+    uint8_t        nal_ref_idc;            // H.264 only
+    uint8_t        nuh_layer_id;           // H.265 only
+    uint8_t        nuh_temporal_id_plus1;  // H.265 only
+};
+
+/**
+ * @brief locate nal units in Annex B byte stream without syntax parsing
+ * @note  no allocation per nal unit, in reader mode the internal buffer only grows to the biggest nal unit
+ */
+class H26xNalIterator
+{
+public:
+    using ptr = std::shared_ptr<H26xNalIterator>;
+public:
+    /**
+     * @note the buffer must outlive the iterator, no copy is made
+     */
+    explicit H26xNalIterator(const uint8_t* data, size_t size, H26xCodecType codec);
+    /**
+     * @note if the reader provides AbstractH26xByteReader::Data(), iterate over it directly
+     */
+    explicit H26xNalIterator(AbstractH26xByteReader::ptr reader, H26xCodecType codec);
+    /**
+     * @brief push mode, bytes are given by Feed chunk by chunk as they arrive
+     */
+    explicit H26xNalIterator(H26xCodecType codec);
+    ~H26xNalIterator() = default;
+public:
+    /**
+     * @brief     push mode, append bytes to the internal buffer
+     * @param[in] data
+     * @param[in] size
+     * @note      view.data got before is invalid after Feed
+     */
+    void Feed(const uint8_t* data, size_t size);
+    /**
+     * @brief push mode, no more bytes, the last nal unit is complete
+     * @note  a later Feed starts a new stream segment
+     */
+    void Flush();
+public:
+    /**
+     * @brief      move to the next nal unit
+     * @param[out] view
+     * @return     false if there is no more nal unit, in push mode no complete nal unit yet
+     * @note       in reader mode and push mode, view.data is only valid until the next call
+     */
+    bool Next(H26xNalUnitView& view);
+private:
+    size_t FindNextStartCode(size_t from);
+    bool   Fill();
+    void   Compact();
+private:
+    H26xCodecType _codec;
+    const uint8_t* _data;
+    size_t _size;
+    size_t _pos;
+private: /* reader mode and push mode */
+    AbstractH26xByteReader::ptr _reader;
+    std::vector<uint8_t> _buf;
+    size_t _base;
+    bool _eof;
+private: /* push mode */
+    bool _push;
+    size_t _scanPos;
+};
+
+/**
+ * @brief classes of a nal unit for key frame detection, in ascending order
+ */
+enum H26xSliceClass
+{
+    MMP_H26X_SLICE_CLASS_NONE     = 0,    // not a slice
+    MMP_H26X_SLICE_CLASS_NON_KEY  = 1,    // H.264 P, B or SP slice; H.265 any slice of a non IRAP picture
+    MMP_H26X_SLICE_CLASS_I_SLICE  = 2,    // H.264 I or SI slice of a non IDR picture
+    MMP_H26X_SLICE_CLASS_IDR      = 3,
+    MMP_H26X_SLICE_CLASS_CRA      = 4,    // H.265 only
+    MMP_H26X_SLICE_CLASS_BLA      = 5     // H.265 only
+};
+
+/**
+ * @brief result of ClassifyNalUnit and ClassifyByteStream
+ */
+class H26xSliceClassification
+{
+public:
+    H26xSliceClassification();
+    ~H26xSliceClassification() = default;
+public:
+    /**
+     * @brief IDR, CRA or BLA
+     */
+    bool IsRandomAccess() const;
+public:
+    H26xSliceClass sliceClass;
+    uint8_t        nal_unit_type;
+    bool           firstSliceInPicture;    // H.264 first_mb_in_slice equal to 0, H.265 first_slice_segment_in_pic_flag
+};
+
+/**
+ * @brief     classify a nal unit from its raw bytes
+ * @param[in] codec
+ * @param[in] data nal unit (header included) without start code, e.g. H26xNalUnitView::data
+ * @param[in] size
+ * @note      stateless and no allocation, only the nal unit header is decoded,
+ *            for H.264 slices first_mb_in_slice and slice_type as well
+ */
+H26xSliceClassification ClassifyNalUnit(H26xCodecType codec, const uint8_t* data, size_t size);
+
+/**
+ * @brief     classify a buffer of Annex B byte stream, e.g. a packet or an access unit
+ * @param[in] codec
+ * @param[in] data
+ * @param[in] size
+ * @return    the classification of the nal unit with the highest class, the first one on a tie
+ * @note      stateless and no allocation, stops at the first random access nal unit
+ */
+H26xSliceClassification ClassifyByteStream(H26xCodecType codec, const uint8_t* data, size_t size);
+
+} // namespace Codec
+} // namespace Mmp
@@ -0,0 +1,71 @@
+#include "H26xSyntaxArena.h"
+
+#include <algorithm>
+#include <new>
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H26xSyntaxArena::H26xSyntaxArena(size_t blockSize)
+{
+    _blockSize = blockSize;
+    _block = 0;
+    _offset = 0;
+    _allocations = 0;
+}
+
+void* H26xSyntaxArena::Allocate(size_t bytes, size_t alignment)
+{
+    while (true)
+    {
+        if (_block < _blocks.size())
+        {
+            Block& block = _blocks[_block];
+            uintptr_t address = reinterpret_cast<uintptr_t>(block.data.get()) + _offset;
+            size_t padding = (alignment - address % alignment) % alignment;
+            if (_offset + padding + bytes <= block.size)
+            {
+                _offset += padding + bytes;
+                _allocations++;
+                return block.data.get() + _offset - bytes;
+            }
+            if (_block + 1 < _blocks.size() && _blocks[_block + 1].size >= bytes + alignment)
+            {
+                // Hint : the next block is kept from before Reset, reuse it
+                _block++;
+                _offset = 0;
+                continue;
+            }
+        }
+        // Hint : a bigger allocation than the block size takes a block of its own
+        Block block;
+        block.size = std::max(_blockSize, bytes + alignment);
+        block.data.reset(new uint8_t[block.size]);
+        size_t index = _blocks.empty() ? 0 : _block + 1;
+        _blocks.insert(_blocks.begin() + index, std::move(block));
+        _block = index;
+        _offset = 0;
+    }
+}
+
+void H26xSyntaxArena::Deallocate(void* /* data */, size_t /* bytes */)
+{
+    // Hint : memory is given back by Reset
+    _allocations--;
+}
+
+bool H26xSyntaxArena::Reset()
+{
+    if (_allocations != 0)
+    {
+        return false;
+    }
+    _block = 0;
+    _offset = 0;
+    return true;
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,108 @@
+//
+// H26xSyntaxArena.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+// 
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief bump allocator for syntax objects, e.g. one arena per access unit
+ * @note  memory is only given back by Reset, all at once; allocations are not thread safe,
+ *        syntax objects may be released on any thread
+ */
+class H26xSyntaxArena
+{
+public:
+    using ptr = std::shared_ptr<H26xSyntaxArena>;
+public:
+    explicit H26xSyntaxArena(size_t blockSize = 64 * 1024);
+    ~H26xSyntaxArena() = default;
+public:
+    void* Allocate(size_t bytes, size_t alignment);
+    void Deallocate(void* data, size_t bytes);
+    /**
+     * @brief  release every allocation at once, the blocks are kept for the next use
+     * @return false if some syntax objects are still referenced, then nothing is released
+     */
+    bool Reset();
+private:
+    struct Block
+    {
+        std::unique_ptr<uint8_t[]> data;
+        size_t                     size;
+    };
+private:
+    size_t _blockSize;
+    std::vector<Block> _blocks;
+    size_t _block;         // index of the block in use
+    size_t _offset;        // offset in the block in use
+    std::atomic<size_t> _allocations;
+};
+
+/**
+ * @brief std allocator on H26xSyntaxArena, for std::allocate_shared
+ * @note  the arena is kept alive by every syntax object allocated from it
+ */
+template <typename T>
+class H26xArenaAllocator
+{
+public:
+    using value_type = T;
+public:
+    explicit H26xArenaAllocator(H26xSyntaxArena::ptr arena) : arena(arena) {}
+    template <typename U>
+    H26xArenaAllocator(const H26xArenaAllocator<U>& other) : arena(other.arena) {}
+public:
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* p, size_t n)
+    {
+        arena->Deallocate(p, n * sizeof(T));
+    }
+public:
+    H26xSyntaxArena::ptr arena;
+};
+
+template <typename T, typename U>
+bool operator==(const H26xArenaAllocator<T>& lhs, const H26xArenaAllocator<U>& rhs)
+{
+    return lhs.arena == rhs.arena;
+}
+
+template <typename T, typename U>
+bool operator!=(const H26xArenaAllocator<T>& lhs, const H26xArenaAllocator<U>& rhs)
+{
+    return lhs.arena != rhs.arena;
+}
+
+/**
+ * @brief     create a syntax object, from the arena if any, otherwise from the heap
+ * @param[in] arena
+ */
+template <typename T>
+std::shared_ptr<T> MakeSyntax(const H26xSyntaxArena::ptr& arena)
+{
+    if (arena)
+    {
+        return std::allocate_shared<T>(H26xArenaAllocator<T>(arena));
+    }
+    return std::make_shared<T>();
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "H26xThreadPool.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+H26xThreadPool::H26xThreadPool(size_t workers)
+{
+    _task = nullptr;
+    _count = 0;
+    _next = 0;
+    _pending = 0;
+    _generation = 0;
+    _stop = false;
+    for (size_t worker=1; worker<workers; worker++)
+    {
+        _threads.emplace_back(&H26xThreadPool::WorkerThread, this, worker);
+    }
+}
+
+H26xThreadPool::~H26xThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _cond.notify_all();
+    for (auto& thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+size_t H26xThreadPool::Workers()
+{
+    return _threads.size() + 1;
+}
+
+void H26xThreadPool::ParallelFor(size_t count, const task& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = &task;
+        _count = count;
+        _next = 0;
+        _pending = _threads.size();
+        _generation++;
+    }
+    _cond.notify_all();
+    RunTasks(0);
+    std::unique_lock<std::mutex> lock(_mutex);
+    _doneCond.wait(lock, [this]() { return _pending == 0; });
+    _task = nullptr;
+}
+
+void H26xThreadPool::RunTasks(size_t worker)
+{
+    for (size_t index = _next++; index < _count; index = _next++)
+    {
+        (*_task)(index, worker);
+    }
+}
+
+void H26xThreadPool::WorkerThread(size_t worker)
+{
+    uint64_t generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cond.wait(lock, [this, generation]() { return _stop || _generation != generation; });
+            if (_stop)
+            {
+                return;
+            }
+            generation = _generation;
+        }
+        RunTasks(worker);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _pending--;
+        }
+        _doneCond.notify_one();
+    }
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
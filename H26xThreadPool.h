@@ -0,0 +1,64 @@
+//
+// H26xThreadPool.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+// 
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief fixed size thread pool for data parallel loops
+ */
+class H26xThreadPool
+{
+public:
+    using ptr = std::shared_ptr<H26xThreadPool>;
+    using task = std::function<void(size_t index, size_t worker)>;
+public:
+    /**
+     * @param[in] workers number of workers, the thread calling ParallelFor included
+     */
+    explicit H26xThreadPool(size_t workers);
+    ~H26xThreadPool();
+public:
+    size_t Workers();
+    /**
+     * @brief     run the task for every index in [0, count), blocks until all are done
+     * @param[in] count
+     * @param[in] task  called with the index and the worker (in [0, Workers())) running it
+     * @note      the calling thread works as worker 0, indexes are taken in ascending order
+     */
+    void ParallelFor(size_t count, const task& task);
+private:
+    void RunTasks(size_t worker);
+    void WorkerThread(size_t worker);
+private:
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::condition_variable _doneCond;
+    const task* _task;
+    size_t _count;
+    std::atomic<size_t> _next;
+    size_t _pending;       // threads still running the current loop
+    uint64_t _generation;
+    bool _stop;
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
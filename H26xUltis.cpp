@@ -7,6 +7,18 @@
 
 #include "H264Common.h"
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MMP_H26X_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MMP_H26X_SSE2
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace Mmp
 {
 namespace Codec
@@ -221,5 +233,106 @@ void FillH264SpsContext(H264SpsSyntax::ptr sps)
     }
 }
 
+static inline uint32_t CountTrailingZeros32(uint32_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctz(value);
+#elif defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward(&index, value);
+    return (uint32_t)index;
+#else
+    uint32_t count = 0;
+    for (; !(value & 0x01); value >>= 1)
+    {
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief find the first (0x00, 0x00, third) byte pattern, third should be greater than 0
+ */
+static size_t FindZeroZeroPattern(const uint8_t* data, size_t size, uint8_t third)
+{
+    size_t pos = 0;
+    // Hint : compare (data[i], data[i+1], data[i+2]) with (0x00, 0x00, third) for a whole vector of i at once
+#if defined(MMP_H26X_AVX2)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i pattern = _mm256_set1_epi8((char)third);
+        for (; pos + 2 + 32 <= size; pos += 32)
+        {
+            __m256i v0 = _mm256_loadu_si256((const __m256i*)(data + pos));
+            __m256i v1 = _mm256_loadu_si256((const __m256i*)(data + pos + 1));
+            __m256i v2 = _mm256_loadu_si256((const __m256i*)(data + pos + 2));
+            __m256i match = _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi8(v0, zero), _mm256_cmpeq_epi8(v1, zero)), _mm256_cmpeq_epi8(v2, pattern));
+            uint32_t mask = (uint32_t)_mm256_movemask_epi8(match);
+            if (mask)
+            {
+                return pos + CountTrailingZeros32(mask);
+            }
+        }
+    }
+#endif /* MMP_H26X_AVX2 */
+#if defined(MMP_H26X_AVX2) || defined(MMP_H26X_SSE2)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i pattern = _mm_set1_epi8((char)third);
+        for (; pos + 2 + 16 <= size; pos += 16)
+        {
+            __m128i v0 = _mm_loadu_si128((const __m128i*)(data + pos));
+            __m128i v1 = _mm_loadu_si128((const __m128i*)(data + pos + 1));
+            __m128i v2 = _mm_loadu_si128((const __m128i*)(data + pos + 2));
+            __m128i match = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(v0, zero), _mm_cmpeq_epi8(v1, zero)), _mm_cmpeq_epi8(v2, pattern));
+            uint32_t mask = (uint32_t)_mm_movemask_epi8(match);
+            if (mask)
+            {
+                return pos + CountTrailingZeros32(mask);
+            }
+        }
+    }
+#endif /* MMP_H26X_AVX2 || MMP_H26X_SSE2 */
+    // Hint : scalar, data[i+2] neither 0 nor third means none of i, i+1 and i+2 could be the begin of the pattern
+    while (pos + 2 < size)
+    {
+        if (data[pos + 2] != 0 && data[pos + 2] != third)
+        {
+            pos += 3;
+        }
+        else if (data[pos + 2] == third && data[pos + 1] == 0 && data[pos] == 0)
+        {
+            return pos;
+        }
+        else
+        {
+            pos++;
+        }
+    }
+    return size;
+}
+
+size_t FindStartCode(const uint8_t* data, size_t size)
+{
+    return FindZeroZeroPattern(data, size, 0x01);
+}
+
+size_t FindEmulationPrevention(const uint8_t* data, size_t size)
+{
+    return FindZeroZeroPattern(data, size, 0x03);
+}
+
+uint64_t HashBytes(const uint8_t* data, size_t size)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i=0; i<size; i++)
+    {
+        hash ^= data[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
 } // namespace Codec
-} // namespace Mmp
\ No newline at end of file
+} // namespace Mmp
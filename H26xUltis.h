@@ -70,6 +70,32 @@ void FillH264SpsContext(H264SpsSyntax::ptr sps);
  */
 void FillH265SpsContext(H265SpsSyntax::ptr sps);
 
+/**
+ * @brief     find the first Annex B start code prefix (0x000001)
+ * @param[in] data
+ * @param[in] size
+ * @return    offset of the start code prefix, size if not found
+ * @note      vectorized with SSE2 or AVX2 when available at compile time
+ */
+size_t FindStartCode(const uint8_t* data, size_t size);
+
+/**
+ * @brief     find the first emulation prevention three byte sequence (0x000003)
+ * @param[in] data
+ * @param[in] size
+ * @return    offset of the sequence, size if not found
+ * @note      vectorized the same way as FindStartCode
+ */
+size_t FindEmulationPrevention(const uint8_t* data, size_t size);
+
+/**
+ * @brief     64 bits FNV-1a hash
+ * @param[in] data
+ * @param[in] size
+ * @note      not cryptographic, only to tell byte identical buffers quickly
+ */
+uint64_t HashBytes(const uint8_t* data, size_t size);
+
 
 } // namespace Codec
 } // namespace Mmp
\ No newline at end of file
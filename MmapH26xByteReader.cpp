@@ -0,0 +1,165 @@
+#include "MmapH26xByteReader.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif /* _WIN32 */
+
+namespace Mmp
+{
+namespace Codec
+{
+
+// Hint : hint the kernel to read ahead this much bytes in front of the read position
+constexpr size_t kWillNeedSize = 16 * 1024 * 1024;
+
+MmapH26xByteReader::MmapH26xByteReader(const std::string& path)
+{
+    _data = nullptr;
+    _size = 0;
+    _pos = 0;
+    _willNeedPos = (size_t)(-1);
+#ifdef _WIN32
+    _file = INVALID_HANDLE_VALUE;
+    _mapping = nullptr;
+    _file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (_file == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(_file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        return;
+    }
+    _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!_mapping)
+    {
+        return;
+    }
+    _data = (const uint8_t*)MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+    if (_data)
+    {
+        _size = (size_t)fileSize.QuadPart;
+    }
+#else
+    _fd = open(path.c_str(), O_RDONLY);
+    if (_fd < 0)
+    {
+        return;
+    }
+    struct stat st;
+    if (fstat(_fd, &st) != 0 || st.st_size == 0)
+    {
+        return;
+    }
+    void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, _fd, 0);
+    if (data == MAP_FAILED)
+    {
+        return;
+    }
+    _data = (const uint8_t*)data;
+    _size = (size_t)st.st_size;
+    madvise(data, _size, MADV_SEQUENTIAL);
+    WillNeed(0);
+#endif /* _WIN32 */
+}
+
+MmapH26xByteReader::~MmapH26xByteReader()
+{
+#ifdef _WIN32
+    if (_data)
+    {
+        UnmapViewOfFile(_data);
+    }
+    if (_mapping)
+    {
+        CloseHandle(_mapping);
+    }
+    if (_file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(_file);
+    }
+#else
+    if (_data)
+    {
+        munmap((void*)_data, _size);
+    }
+    if (_fd >= 0)
+    {
+        close(_fd);
+    }
+#endif /* _WIN32 */
+}
+
+bool MmapH26xByteReader::IsOpen()
+{
+    return _data != nullptr;
+}
+
+size_t MmapH26xByteReader::Read(void* data, size_t bytes)
+{
+    size_t readBytes = bytes < _size - _pos ? bytes : _size - _pos;
+    if (readBytes == 0)
+    {
+        return 0;
+    }
+    memcpy(data, _data + _pos, readBytes);
+    _pos += readBytes;
+    WillNeed(_pos);
+    return readBytes;
+}
+
+bool MmapH26xByteReader::Seek(size_t offset)
+{
+    _pos = offset < _size ? offset : _size;
+    WillNeed(_pos);
+    return _pos == offset;
+}
+
+size_t MmapH26xByteReader::Tell()
+{
+    return _pos;
+}
+
+bool MmapH26xByteReader::Eof()
+{
+    return _pos >= _size;
+}
+
+const uint8_t* MmapH26xByteReader::Data()
+{
+    return _data;
+}
+
+size_t MmapH26xByteReader::Size()
+{
+    return _size;
+}
+
+void MmapH26xByteReader::WillNeed(size_t offset)
+{
+#ifndef _WIN32
+    // Hint : only when the read position leaves the window hinted last time
+    if (!_data || (offset >= _willNeedPos && offset < _willNeedPos + kWillNeedSize / 2))
+    {
+        return;
+    }
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t begin = offset / pageSize * pageSize;
+    size_t length = begin + kWillNeedSize < _size ? kWillNeedSize : _size - begin;
+    madvise((void*)(_data + begin), length, MADV_WILLNEED);
+    _willNeedPos = offset;
+#else
+    (void)offset;
+#endif /* _WIN32 */
+}
+
+} // namespace Codec
+} // namespace Mmp
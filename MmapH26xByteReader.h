@@ -0,0 +1,61 @@
+//
+// MmapH26xByteReader.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+// 
+
+#pragma once
+
+#include <string>
+
+#include "AbstractH26xByteReader.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief memory mapped AbstractH26xByteReader implemention
+ * @note  the whole file is mapped read only, H26xBinaryReader parses directly from the mapping
+ */
+class MmapH26xByteReader final : public AbstractH26xByteReader
+{
+public:
+    using ptr = std::shared_ptr<MmapH26xByteReader>;
+public:
+    explicit MmapH26xByteReader(const std::string& path);
+    ~MmapH26xByteReader();
+public:
+    /**
+     * @brief whether the file is mapped successfully
+     */
+    bool IsOpen();
+public:
+    size_t Read(void* data, size_t bytes) override;
+    bool Seek(size_t offset) override;
+    size_t Tell() override;
+    bool Eof() override;
+public:
+    const uint8_t* Data() override;
+    size_t Size() override;
+private:
+    void WillNeed(size_t offset);
+private:
+    const uint8_t* _data;
+    size_t _size;
+    size_t _pos;
+    size_t _willNeedPos;
+private:
+#ifdef _WIN32
+    void* _file;
+    void* _mapping;
+#else
+    int _fd;
+#endif /* _WIN32 */
+};
+
+} // namespace Codec
+} // namespace Mmp
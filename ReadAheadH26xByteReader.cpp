@@ -0,0 +1,165 @@
+#include "ReadAheadH26xByteReader.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Mmp
+{
+namespace Codec
+{
+
+ReadAheadH26xByteReader::ReadAheadH26xByteReader(AbstractH26xByteReader::ptr reader, size_t blockSize, size_t depth)
+{
+    _reader = reader;
+    _blockSize = blockSize ? blockSize : 1;
+    _pos = _reader->Tell();
+    _cur = 0;
+    _blocks.resize(depth ? depth : 1);
+    for (Block& block : _blocks)
+    {
+        block.data.resize(_blockSize);
+        block.offset = 0;
+        block.size = 0;
+    }
+    _head = 0;
+    _count = 0;
+    _end = false;
+    _stop = false;
+    Start();
+}
+
+ReadAheadH26xByteReader::~ReadAheadH26xByteReader()
+{
+    Stop();
+}
+
+size_t ReadAheadH26xByteReader::Read(void* data, size_t bytes)
+{
+    size_t readBytes = 0;
+    while (readBytes < bytes)
+    {
+        Block* block = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cond.wait(lock, [this] { return _count != 0 || _end; });
+            if (_count == 0) /* eof */
+            {
+                break;
+            }
+            block = &_blocks[_head];
+        }
+        // Hint : the head block is not touched by the helper thread until it is given back
+        size_t copyBytes = std::min(bytes - readBytes, block->size - _cur);
+        memcpy((uint8_t*)data + readBytes, block->data.data() + _cur, copyBytes);
+        _cur += copyBytes;
+        _pos += copyBytes;
+        readBytes += copyBytes;
+        if (_cur == block->size)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _head = (_head + 1) % _blocks.size();
+            _count--;
+            _cur = 0;
+            _cond.notify_all();
+        }
+    }
+    return readBytes;
+}
+
+bool ReadAheadH26xByteReader::Seek(size_t offset)
+{
+    if (offset == _pos)
+    {
+        return true;
+    }
+    {
+        // Hint : inside the blocks read ahead, drop the blocks in front of it
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (size_t i = 0; i < _count; i++)
+        {
+            const Block& block = _blocks[(_head + i) % _blocks.size()];
+            if (offset >= block.offset && offset < block.offset + block.size)
+            {
+                _head = (_head + i) % _blocks.size();
+                _count -= i;
+                _cur = offset - block.offset;
+                _pos = offset;
+                _cond.notify_all();
+                return true;
+            }
+        }
+    }
+    Stop();
+    bool res = _reader->Seek(offset);
+    _pos = _reader->Tell();
+    Start();
+    return res;
+}
+
+size_t ReadAheadH26xByteReader::Tell()
+{
+    return _pos;
+}
+
+bool ReadAheadH26xByteReader::Eof()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _count == 0 && _end;
+}
+
+void ReadAheadH26xByteReader::Start()
+{
+    _head = 0;
+    _count = 0;
+    _cur = 0;
+    _end = false;
+    _stop = false;
+    _thread = std::thread(&ReadAheadH26xByteReader::ReadAheadThread, this, _pos);
+}
+
+void ReadAheadH26xByteReader::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+        _cond.notify_all();
+    }
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+}
+
+void ReadAheadH26xByteReader::ReadAheadThread(size_t offset)
+{
+    while (true)
+    {
+        size_t index = 0;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cond.wait(lock, [this] { return _count < _blocks.size() || _stop; });
+            if (_stop)
+            {
+                return;
+            }
+            index = (_head + _count) % _blocks.size();
+        }
+        // Hint : the free block is owned by this thread until it is counted in
+        Block& block = _blocks[index];
+        block.offset = offset;
+        block.size = _reader->Read(block.data.data(), _blockSize);
+        offset += block.size;
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (block.size == 0)
+        {
+            _end = true;
+            _cond.notify_all();
+            return;
+        }
+        _count++;
+        _cond.notify_all();
+    }
+}
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
@@ -0,0 +1,72 @@
+//
+// ReadAheadH26xByteReader.h
+//
+// Library: Codec
+// Package: H26x
+// Module:  H26x
+// 
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "AbstractH26xByteReader.h"
+
+namespace Mmp
+{
+namespace Codec
+{
+
+/**
+ * @brief read ahead AbstractH26xByteReader implemention, wraps another reader
+ * @note  blocks of the wrapped reader are read on a helper thread into a ring of buffers,
+ *        so I/O (e.g. disk or network storage) overlaps with parsing
+ */
+class ReadAheadH26xByteReader final : public AbstractH26xByteReader
+{
+public:
+    using ptr = std::shared_ptr<ReadAheadH26xByteReader>;
+public:
+    /**
+     * @param[in] reader    the wrapped reader, only accessed by the helper thread since then
+     * @param[in] blockSize bytes read from the wrapped reader at once
+     * @param[in] depth     number of blocks read ahead, memory is bounded by blockSize * depth
+     */
+    explicit ReadAheadH26xByteReader(AbstractH26xByteReader::ptr reader, size_t blockSize = 1024 * 1024, size_t depth = 4);
+    ~ReadAheadH26xByteReader();
+public:
+    size_t Read(void* data, size_t bytes) override;
+    bool Seek(size_t offset) override;
+    size_t Tell() override;
+    bool Eof() override;
+private:
+    void Start();
+    void Stop();
+    void ReadAheadThread(size_t offset);
+private:
+    struct Block
+    {
+        std::vector<uint8_t> data;
+        size_t               offset;
+        size_t               size;
+    };
+private:
+    AbstractH26xByteReader::ptr _reader;
+    size_t _blockSize;
+    size_t _pos;
+    size_t _cur;           // read position in the head block
+private: /* ring of blocks, guarded by _mutex */
+    std::vector<Block> _blocks;
+    size_t _head;
+    size_t _count;
+    bool   _end;
+    bool   _stop;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::thread _thread;
+};
+
+} // namespace Codec
+} // namespace Mmp
\ No newline at end of file
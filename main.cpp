@@ -7,11 +7,16 @@
 #include <sstream>
 #include <chrono>
 #include <string>
+#include <algorithm>
 
 #include "AbstractH26xByteReader.h"
 #include "H26xBinaryReader.h"
+#include "MmapH26xByteReader.h"
+#include "ReadAheadH26xByteReader.h"
 #include "H264Deserialize.h"
 #include "H265Deserialize.h"
+#include "H264AccessUnit.h"
+#include "H265AccessUnit.h"
 
 namespace Mmp
 {
@@ -58,6 +63,7 @@ size_t SimpleFileH264ByteReader::Read(void* data, size_t bytes)
 
 bool SimpleFileH264ByteReader::Seek(size_t offset)
 {
+    _ifs.clear();
     _ifs.seekg(offset);
     return _ifs.tellg() == offset;
 }
@@ -95,6 +101,8 @@ public:
     bool Seek(size_t offset) override;
     size_t Tell() override;
     bool Eof() override;
+private:
+    bool Reload(size_t offset);
 private:
     std::ifstream _ifs;
 private:
@@ -127,61 +135,46 @@ CacheFileH264ByteReader::~CacheFileH264ByteReader()
 
 size_t CacheFileH264ByteReader::Read(void* data, size_t bytes)
 {
-    if (_cur + bytes < _len)
-    {
-        memcpy(data, _buf + _cur, bytes);
-        _cur += bytes;
-        return bytes;
-    }
-    else if (_ifs.eof())
-    {
-        memcpy(data, _buf + _cur, _len -  _cur);
-        return _len -  _cur;
-    }
-    else
+    size_t readBytes = 0;
+    while (readBytes < bytes)
     {
-        _offset = _ifs.tellg();
-        _ifs.readsome((char*)_buf, kBufSize);
-        _cur = 0;
-        _len = _ifs.gcount(); 
-        if (_len == 0) /* eof */
-        {
-            return 0;
-        }
-        else
+        if (_cur == _len && !Reload(_offset + _len)) /* eof */
         {
-            return Read(data, bytes);
+            break;
         }
+        size_t copyBytes = std::min<size_t>(bytes - readBytes, _len - _cur);
+        memcpy((uint8_t*)data + readBytes, _buf + _cur, copyBytes);
+        _cur += (uint32_t)copyBytes;
+        readBytes += copyBytes;
     }
+    return readBytes;
 }
 
 bool CacheFileH264ByteReader::Seek(size_t offset)
 {
-    if (offset < _offset)
+    if (offset >= _offset && offset <= _offset + _len)
     {
-        _ifs.seekg(offset);
-        _offset = _ifs.tellg();
-        _ifs.readsome((char*)_buf, kBufSize);
-        _cur = 0;
-        _len = _ifs.gcount(); 
-        return _offset == offset;
-    }
-    else if (offset > _offset + kBufSize)
-    {
-        _ifs.seekg(offset);
-        _offset = _ifs.tellg();
-        _ifs.readsome((char*)_buf, kBufSize);
-        _cur = 0;
-        _len = _ifs.gcount(); 
-        return _offset == offset;
+        _cur = (uint32_t)(offset - _offset);
+        return true;
     }
     else
     {
-        _cur = offset - _offset;
-        return true;
+        Reload(offset);
+        return _offset == offset;
     }
 }
 
+bool CacheFileH264ByteReader::Reload(size_t offset)
+{
+    _ifs.clear();
+    _ifs.seekg(offset);
+    _offset = (uint32_t)offset;
+    _ifs.read((char*)_buf, kBufSize);
+    _cur = 0;
+    _len = (uint32_t)_ifs.gcount();
+    return _len != 0;
+}
+
 size_t CacheFileH264ByteReader::Tell()
 {
     return _offset + _cur;
@@ -189,7 +182,7 @@ size_t CacheFileH264ByteReader::Tell()
 
 bool CacheFileH264ByteReader::Eof()
 {
-    return _len == 0 || (_ifs.eof() && _cur == _len);
+    return _cur == _len && _ifs.eof();
 }
 
 } // namespace Codec
@@ -279,14 +272,25 @@ int main(int argc, char* argv[])
     }
 #if 0 /* slow but simple */
     AbstractH26xByteReader::ptr byteReader = std::make_shared<SimpleFileH264ByteReader>(std::string(argv[1]));
-#else /* fast but a bit complicated  */
+#elif 0 /* fast but a bit complicated  */
     AbstractH26xByteReader::ptr byteReader = std::make_shared<CacheFileH264ByteReader>(std::string(argv[1]));
+#elif 0 /* read ahead on a helper thread, for slow storage */
+    AbstractH26xByteReader::ptr byteReader = std::make_shared<ReadAheadH26xByteReader>(std::make_shared<SimpleFileH264ByteReader>(std::string(argv[1])));
+#else /* zero copy, provided by the library */
+    MmapH26xByteReader::ptr mmapReader = std::make_shared<MmapH26xByteReader>(std::string(argv[1]));
+    if (!mmapReader->IsOpen())
+    {
+        Usage();
+        return -1;
+    }
+    AbstractH26xByteReader::ptr byteReader = mmapReader;
 #endif
     if (std::string(argv[1]).find(".h264") != std::string::npos)
     {
         H26xBinaryReader::ptr binaryReader = std::make_shared<H26xBinaryReader>(byteReader);
         H264Deserialize::ptr deserialize = std::make_shared<H264Deserialize>();
-        std::vector<H264NalSyntax::ptr> nals;
+        H264AccessUnitAssembler::ptr assembler = std::make_shared<H264AccessUnitAssembler>();
+        std::vector<H264AccessUnit::ptr> aus;
         bool res = true;
         int num = 0;
         auto begin = std::chrono::system_clock::now();
@@ -301,16 +305,26 @@ int main(int argc, char* argv[])
                     << std::endl;
             if (res)
             {
-                nals.push_back(nal);
+                H264AccessUnit::ptr au = assembler->Push(nal);
+                if (au)
+                {
+                    aus.push_back(au);
+                }
             }
         } while (res && !binaryReader->Eof());
+        if (H264AccessUnit::ptr au = assembler->Flush())
+        {
+            aus.push_back(au);
+        }
+        std::cout << "access unit num : " << aus.size() << std::endl;
         std::cout << "total cost time : " << (std::chrono::system_clock::now() - begin).count() / (1000 * 1000) << "ms";
     }
     else if (std::string::npos && std::string(argv[1]).find(".h265") != std::string::npos)
     {
         H26xBinaryReader::ptr binaryReader = std::make_shared<H26xBinaryReader>(byteReader);
         H265Deserialize::ptr deserialize = std::make_shared<H265Deserialize>();
-        std::vector<H265NalSyntax::ptr> nals;
+        H265AccessUnitAssembler::ptr assembler = std::make_shared<H265AccessUnitAssembler>();
+        std::vector<H265AccessUnit::ptr> aus;
         bool res = true;
         int num = 0;
         auto begin = std::chrono::system_clock::now();
@@ -325,9 +339,18 @@ int main(int argc, char* argv[])
                     << std::endl;
             if (res)
             {
-                nals.push_back(nal);
+                H265AccessUnit::ptr au = assembler->Push(nal);
+                if (au)
+                {
+                    aus.push_back(au);
+                }
             }
         } while (res && !binaryReader->Eof());
+        if (H265AccessUnit::ptr au = assembler->Flush())
+        {
+            aus.push_back(au);
+        }
+        std::cout << "access unit num : " << aus.size() << std::endl;
         std::cout << "total cost time : " << (std::chrono::system_clock::now() - begin).count() / (1000 * 1000) << "ms";
     }
 